@@ -46,6 +46,23 @@ int main(int argc, char *argv[])
     size_t run_amount = 9;
 #endif // TRIAL_RUN
 
+    // --log-level=<none|progress|debug|verbose> limits the printed output, only levels that are compiled in can be printed
+    const std::string log_level_flag = "--log-level=";
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string argument = argv[i];
+        if (argument.rfind(log_level_flag, 0) == 0)
+        {
+            tattletale::LogLevel log_level = tattletale::StringToLogLevel(argument.substr(log_level_flag.size()));
+            TATTLETALE_ERROR_PRINT(log_level != tattletale::LogLevel::kLast, fmt::format("Unknown log level in {}", argument));
+            if (log_level != tattletale::LogLevel::kLast)
+            {
+                setting.log_level = log_level;
+            }
+        }
+    }
+    tattletale::SetLogLevel(setting.log_level);
+
     tattletale::Random random;
     tattletale::Chronicle chronicle(random);
 
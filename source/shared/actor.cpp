@@ -17,12 +17,16 @@ namespace tattletale
           chronicle_(school.GetChronicle()),
           school_(school),
           interaction_store_(school.GetInteractionStore()),
+          actor_state_store_(school.GetChronicle().GetActorStateStore()),
+          relationship_store_(school.GetChronicle().GetRelationshipStore()),
           id_(id),
           first_name_(first_name),
           last_name_(last_name),
           name_(first_name + " " + last_name)
     {
         enrolled_courses_id_ = std::vector<int>(setting_.slot_count_per_week(), -1);
+        actor_state_store_.AddActor(id_);
+        relationship_store_.AddActor(id_);
     }
 
     void Actor::SetupRandomValues(size_t tick)
@@ -32,6 +36,25 @@ namespace tattletale
         InitializeRandomRelationships(tick);
         InitializeRandomGoal(tick);
     }
+    void Actor::SetWealth(Resource *wealth)
+    {
+        wealth_ = wealth;
+        actor_state_store_.SetWealth(id_, wealth->GetValue());
+        ++state_version_;
+    }
+    void Actor::SetEmotion(Emotion *emotion)
+    {
+        int type_index = static_cast<int>(emotion->GetType());
+        emotions_[type_index] = emotion;
+        actor_state_store_.SetEmotion(id_, type_index, emotion->GetValue());
+        ++state_version_;
+    }
+    void Actor::SetGoal(Goal *goal)
+    {
+        goal_ = goal;
+        actor_state_store_.SetGoalType(id_, goal->type_);
+        ++state_version_;
+    }
 
     bool Actor::IsEnrolledInCourse(size_t course_id) const
     {
@@ -77,102 +100,147 @@ namespace tattletale
 
     int Actor::ChooseInteraction(const std::list<Actor *> &actor_group, ContextType context, std::vector<Kernel *> &out_reasons, std::vector<Actor *> &out_participants, float &out_chance)
     {
-        // Finding possible Interactions
-        const std::vector<std::shared_ptr<InteractionRequirement>> &requirements = interaction_store_.GetRequirementCatalogue();
-        std::vector<size_t> possible_interaction_indices;
-        for (size_t i = 0; i < requirements.size(); ++i)
+        DecisionCache &cache = decision_caches_[static_cast<size_t>(context)];
+        size_t day = school_.GetCurrentDay();
+        if (!cache.valid || cache.state_version != state_version_ || cache.day != day || cache.group_size != actor_group.size())
         {
-            if (CheckRequirements(*requirements[i], actor_group, context))
-            {
-                possible_interaction_indices.push_back(i);
-            }
+            RefreshDecisionCache(cache, actor_group.size(), context);
         }
-        if (possible_interaction_indices.size() == 0)
+        if (cache.possible_interaction_indices.size() == 0)
         {
             return -1;
         }
 
-        // Calculating chances for each Interaction
-        const std::vector<std::shared_ptr<InteractionTendency>> &tendencies = interaction_store_.GetTendencyCatalogue();
-        std::vector<float> chances;
-        std::vector<Kernel *> tendency_reasons;
-        std::vector<Kernel *> goal_reasons;
-        chances.reserve(possible_interaction_indices.size());
-        tendency_reasons.reserve(possible_interaction_indices.size());
-        goal_reasons.reserve(possible_interaction_indices.size());
-        uint32_t zero_count = 0;
-        for (auto &i : possible_interaction_indices)
-        {
-            std::shared_ptr<InteractionTendency> tendency = tendencies[i];
-            Kernel *tendency_reason = nullptr;
-            float chance = CalculateInteractionChance(*tendency, context, tendency_reason);
-            Kernel *goal_reason = nullptr;
-            float modified_chance = ApplyGoalChanceModification(chance, i, goal_reason);
-            if (modified_chance == 0.0f)
-            {
-                ++zero_count;
-            }
-            chances.push_back(modified_chance);
-            tendency_reasons.push_back(tendency_reason);
-            goal_reasons.push_back(goal_reason);
-        }
-
         // Picking Interaction
-        size_t index = random_.PickIndex(chances, (zero_count == chances.size()));
-        if (tendency_reasons[index])
+        const std::vector<std::shared_ptr<InteractionRequirement>> &requirements = interaction_store_.GetRequirementCatalogue();
+        const std::vector<std::shared_ptr<InteractionTendency>> &tendencies = interaction_store_.GetTendencyCatalogue();
+        size_t index = random_.PickIndex(cache.chances, (cache.zero_count == cache.chances.size()));
+        size_t interaction_index = cache.possible_interaction_indices[index];
+        // reasons are only needed for the picked Interaction
+        Kernel *tendency_reason = nullptr;
+        CalculateInteractionChance(*tendencies[interaction_index], context, tendency_reason);
+        Kernel *goal_reason = nullptr;
+        ApplyGoalChanceModification(cache.base_chances[index], interaction_index, goal_reason);
+        if (tendency_reason)
         {
-            out_reasons.push_back(tendency_reasons[index]);
+            out_reasons.push_back(tendency_reason);
         }
-        if (goal_reasons[index])
+        if (goal_reason)
         {
-            out_reasons.push_back(goal_reasons[index]);
+            out_reasons.push_back(goal_reason);
         }
-        out_chance = chances[index];
-        size_t interaction_index = possible_interaction_indices[index];
+        out_chance = cache.chances[index];
 
         // Choosing Participants:
         out_participants.push_back(this);
-        std::shared_ptr<InteractionRequirement> requirement = requirements[interaction_index];
-        std::shared_ptr<InteractionTendency> tendency = tendencies[interaction_index];
-        for (size_t i = 1; i < requirement->participant_count; ++i)
+        const InteractionRequirement &requirement = *requirements[interaction_index];
+        const InteractionTendency &tendency = *tendencies[interaction_index];
+        if (requirement.participant_count > 1)
+        {
+            // relationships are only looked up once per group member, chosen members get masked out in place
+            participant_group_.assign(actor_group.begin(), actor_group.end());
+            participant_relationships_.clear();
+            participant_chosen_.clear();
+            for (auto &member : participant_group_)
+            {
+                participant_relationships_.push_back(relationship_store_.GetRelationship(id_, member->id_));
+                participant_chosen_.push_back(member->id_ == id_);
+            }
+        }
+        for (size_t i = 1; i < requirement.participant_count; ++i)
         {
             uint32_t participant_zero_count = 0;
-            std::vector<float> participant_chances;
-            std::vector<Kernel *> participant_reasons;
-
-            for (auto &participant : actor_group)
+            participant_chances_.clear();
+            for (size_t member_index = 0; member_index < participant_group_.size(); ++member_index)
             {
-                Kernel *reason = nullptr;
-                float chance = CalculateParticipantChance(participant, i, requirement, tendency, reason);
-                for (auto &already_chosen_participant : out_participants)
+                float chance = 0.0f;
+                if (!participant_chosen_[member_index])
                 {
-                    if (participant->id_ == already_chosen_participant->id_)
-                    {
-                        chance = 0;
-                    }
+                    int reason_type_index = -1;
+                    chance = CalculateParticipantChance(participant_group_[member_index]->id_, participant_relationships_[member_index], i, requirement, tendency, reason_type_index);
                 }
                 if (chance == 0.0f)
                 {
                     participant_zero_count++;
                 }
-                participant_chances.push_back(chance);
-                participant_reasons.push_back(reason);
+                participant_chances_.push_back(chance);
             }
-            if ((participant_zero_count == participant_chances.size()))
+            if ((participant_zero_count == participant_chances_.size()))
             {
                 return -1;
             }
-            size_t participant_index = random_.PickIndex(participant_chances);
-            auto chosen_actor = std::next(actor_group.begin(), participant_index);
-            out_participants.push_back((*chosen_actor));
-            if (participant_reasons[participant_index])
+            size_t participant_index = random_.PickIndex(participant_chances_);
+            Actor *chosen_actor = participant_group_[participant_index];
+            out_participants.push_back(chosen_actor);
+            // the reason is only needed for the picked participant
+            int reason_type_index = -1;
+            CalculateParticipantChance(chosen_actor->id_, participant_relationships_[participant_index], i, requirement, tendency, reason_type_index);
+            if (reason_type_index != -1)
             {
-                out_reasons.push_back(participant_reasons[participant_index]);
+                out_reasons.push_back(relationships_.at(chosen_actor->id_)[reason_type_index]);
+            }
+            for (size_t member_index = 0; member_index < participant_group_.size(); ++member_index)
+            {
+                if (participant_group_[member_index]->id_ == chosen_actor->id_)
+                {
+                    participant_chosen_[member_index] = 1;
+                }
             }
         }
 
         return interaction_index;
     }
+
+    void Actor::RefreshDecisionCache(DecisionCache &cache, size_t group_size, ContextType context)
+    {
+        cache.valid = true;
+        cache.state_version = state_version_;
+        cache.day = school_.GetCurrentDay();
+        cache.group_size = group_size;
+        cache.possible_interaction_indices.clear();
+        cache.base_chances.clear();
+        cache.chances.clear();
+        cache.zero_count = 0;
+
+        // Finding possible Interactions
+        const std::vector<std::shared_ptr<InteractionRequirement>> &requirements = interaction_store_.GetRequirementCatalogue();
+        InteractionStore::CandidateRange candidate_indices = interaction_store_.GetCandidateIndices(context, actor_state_store_.GetGoalType(id_), group_size, cache.day);
+        EmotionValues emotions;
+        for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+        {
+            emotions[type_index] = actor_state_store_.GetEmotion(id_, type_index);
+        }
+        interaction_store_.CalculateEmotionRequirementMask(emotions, emotion_requirement_mask_);
+        for (auto &i : candidate_indices)
+        {
+            // context, goal, group size and day are already covered by the candidates, emotions by the mask
+            bool emotions_met = (emotion_requirement_mask_[i / 64] >> (i % 64)) & 1;
+            if (emotions_met && CheckRelationshipRequirements(*requirements[i]))
+            {
+                cache.possible_interaction_indices.push_back(i);
+            }
+        }
+        if (cache.possible_interaction_indices.size() == 0)
+        {
+            return;
+        }
+        // the candidates are sorted by unlock day, picks have to happen in catalogue order to stay reproducible
+        std::sort(cache.possible_interaction_indices.begin(), cache.possible_interaction_indices.end());
+
+        // Calculating chances for each Interaction
+        interaction_store_.CalculateTendencyChances(GetTendencyFeatures(context), tendency_chances_);
+        for (auto &i : cache.possible_interaction_indices)
+        {
+            Kernel *goal_reason = nullptr;
+            float modified_chance = ApplyGoalChanceModification(tendency_chances_[i], i, goal_reason);
+            if (modified_chance == 0.0f)
+            {
+                ++cache.zero_count;
+            }
+            cache.base_chances.push_back(tendency_chances_[i]);
+            cache.chances.push_back(modified_chance);
+        }
+    }
     bool Actor::CheckRequirements(const InteractionRequirement &requirement, const std::list<Actor *> &actor_group, ContextType context) const
     {
         if (requirement.context != ContextType::kLast && requirement.context != context)
@@ -183,7 +251,7 @@ namespace tattletale
         {
             return false;
         }
-        if (requirement.goal_type != GoalType::kLast && requirement.goal_type != goal_->type_)
+        if (requirement.goal_type != GoalType::kLast && requirement.goal_type != actor_state_store_.GetGoalType(id_))
         {
             return false;
         }
@@ -196,51 +264,33 @@ namespace tattletale
             float value = requirement.emotions[0][type_index];
             if (value < 0)
             {
-                if (emotions_[type_index]->GetValue() > value)
+                if (actor_state_store_.GetEmotion(id_, type_index) > value)
                 {
                     return false;
                 }
             }
             else if (value > 0)
             {
-                if (emotions_[type_index]->GetValue() < value)
+                if (actor_state_store_.GetEmotion(id_, type_index) < value)
                 {
                     return false;
                 }
             }
         }
-        bool match_found = true;
+        return CheckRelationshipRequirements(requirement);
+    }
+    bool Actor::CheckRelationshipRequirements(const InteractionRequirement &requirement) const
+    {
+        // an Actor without any Relationship has always passed this check, so it is kept that way
+        if (relationship_store_.GetRelationshipCount(id_) == 0)
+        {
+            return true;
+        }
         for (size_t participant_id = 1; participant_id < requirement.participant_count; ++participant_id)
         {
             if (requirement.HasRelationshipRequirement(participant_id))
             {
-                for (auto &[actor_id, relationship] : relationships_)
-                {
-                    match_found = true;
-                    for (int type_index = 0; type_index < relationship.size(); ++type_index)
-                    {
-                        float value = requirement.relationship[participant_id - 1][type_index];
-                        if (value < 0)
-                        {
-                            if (relationship.at(type_index)->GetValue() > value)
-                            {
-                                match_found = false;
-                            }
-                        }
-                        else if (value > 0)
-                        {
-                            if (relationship.at(type_index)->GetValue() < value)
-                            {
-                                match_found = false;
-                            }
-                        }
-                    }
-                    if (match_found)
-                    {
-                        break;
-                    }
-                }
-                if (!match_found)
+                if (!relationship_store_.HasRelationshipWithinThresholds(id_, requirement.relationship[participant_id - 1]))
                 {
                     return false;
                 }
@@ -251,82 +301,79 @@ namespace tattletale
 
     float Actor::CalculateParticipantChance(const Actor *participant, size_t participant_id, const std::shared_ptr<InteractionRequirement> &requirement, const std::shared_ptr<InteractionTendency> &tendency, Kernel *&out_reason)
     {
-        size_t id = participant->id_;
-        if (relationships_.count(id))
+        int reason_type_index = -1;
+        float chance = CalculateParticipantChance(participant->id_, relationship_store_.GetRelationship(id_, participant->id_), participant_id, *requirement, *tendency, reason_type_index);
+        if (reason_type_index != -1)
         {
-            std::vector<Relationship *> relationship_vector = relationships_[id];
-
-            float chance = 0.0f;
-            float highest_chance_increase = 0.0f;
-            bool requirement_failed = false;
+            out_reason = relationships_.at(participant->id_)[reason_type_index];
+        }
+        return chance;
+    }
+    float Actor::CalculateParticipantChance(size_t actor_id, const float *relationship, size_t participant_id, const InteractionRequirement &requirement, const InteractionTendency &tendency, int &out_reason_type_index) const
+    {
+        if (!relationship)
+        {
+            return (requirement.HasRelationshipRequirement(participant_id) ? 0.0f : 0.5f);
+        }
+        float chance = 0.0f;
+        float highest_chance_increase = 0.0f;
+        bool requirement_failed = false;
+        const RelationshipValues &relationship_tendency = tendency.relationships[participant_id - 1];
+        const RelationshipValues &relationship_requirement = requirement.relationship[participant_id - 1];
+        for (int type_index = 0; type_index < static_cast<int>(RelationshipType::kLast); ++type_index)
+        {
+            float current_chance_increase = relationship[type_index] * relationship_tendency[type_index];
+            chance += current_chance_increase;
 
-            for (int type_index = 0; type_index < static_cast<int>(RelationshipType::kLast); ++type_index)
+            if (current_chance_increase > highest_chance_increase)
             {
-                Relationship *relationship = relationship_vector[type_index];
-                float current_chance_increase = relationship->GetValue() * tendency->relationships[participant_id - 1][type_index];
-                chance += current_chance_increase;
-
-                if (current_chance_increase > highest_chance_increase)
-                {
-                    highest_chance_increase = current_chance_increase;
-                    out_reason = relationship;
-                }
-                float relationship_requirement_value = requirement->relationship[participant_id - 1][type_index];
-                if (relationship_requirement_value < 0)
+                highest_chance_increase = current_chance_increase;
+                out_reason_type_index = type_index;
+            }
+            float relationship_requirement_value = relationship_requirement[type_index];
+            if (relationship_requirement_value < 0)
+            {
+                if (relationship[type_index] > relationship_requirement_value)
                 {
-                    if (relationship->GetValue() > relationship_requirement_value)
-                    {
-                        requirement_failed = true;
-                    }
+                    requirement_failed = true;
                 }
-                else if (relationship_requirement_value > 0)
+            }
+            else if (relationship_requirement_value > 0)
+            {
+                if (relationship[type_index] < relationship_requirement_value)
                 {
-                    if (relationship->GetValue() < relationship_requirement_value)
-                    {
-                        requirement_failed = true;
-                    }
+                    requirement_failed = true;
                 }
             }
+        }
 
-            for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+        const EmotionValues &emotion_requirement = requirement.emotions[participant_id];
+        for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+        {
+            float emotional_value = emotion_requirement[type_index];
+            if (emotional_value < 0)
             {
-                float emotional_value = requirement->emotions[participant_id][type_index];
-                if (emotional_value < 0)
-                {
-                    if (participant->emotions_[type_index]->GetValue() > emotional_value)
-                    {
-                        requirement_failed = true;
-                    }
-                }
-                else if (emotional_value > 0)
+                if (actor_state_store_.GetEmotion(actor_id, type_index) > emotional_value)
                 {
-                    if (participant->emotions_[type_index]->GetValue() < emotional_value)
-                    {
-                        requirement_failed = true;
-                    }
+                    requirement_failed = true;
                 }
             }
-            if (requirement_failed)
+            else if (emotional_value > 0)
             {
-                return 0.0f;
+                if (actor_state_store_.GetEmotion(actor_id, type_index) < emotional_value)
+                {
+                    requirement_failed = true;
+                }
             }
-            float tendency_parts = static_cast<float>(RelationshipType::kLast);
-            chance += tendency_parts;
-            chance /= (tendency_parts * 2);
-            return chance;
         }
-        else
+        if (requirement_failed)
         {
-            if (requirement->HasRelationshipRequirement(participant_id))
-            {
-                return 0.0f;
-            }
-            else
-            {
-                return 0.5f;
-            }
+            return 0.0f;
         }
-        return 0.0f;
+        float tendency_parts = static_cast<float>(RelationshipType::kLast);
+        chance += tendency_parts;
+        chance /= (tendency_parts * 2);
+        return chance;
     }
     float Actor::CalculateInteractionChance(const InteractionTendency &tendency, const ContextType &context, Kernel *&out_reason)
     {
@@ -345,7 +392,7 @@ namespace tattletale
             ++chance_parts;
         }
 
-        current_chance_increase = tendency.wealth * wealth_->GetValue();
+        current_chance_increase = tendency.wealth * actor_state_store_.GetWealth(id_);
         chance += current_chance_increase;
         ++chance_parts;
         if (current_chance_increase > highest_chance_influence)
@@ -357,7 +404,7 @@ namespace tattletale
         for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
         {
             float value = tendency.emotions[type_index];
-            current_chance_increase = (value * emotions_[type_index]->GetValue());
+            current_chance_increase = (value * actor_state_store_.GetEmotion(id_, type_index));
             chance += current_chance_increase;
             ++chance_parts;
             if (current_chance_increase > highest_chance_influence)
@@ -371,56 +418,26 @@ namespace tattletale
         chance /= static_cast<float>(chance_parts * 2);
         return chance;
     }
-    float Actor::ApplyGoalChanceModification(float original_chance, size_t interaction_index, Kernel *&out_reason)
+    std::array<float, InteractionStore::tendency_feature_count_> Actor::GetTendencyFeatures(ContextType context) const
     {
-        float relevant_effect = 0;
-        const auto &effects = interaction_store_.GetRelationshipEffects(interaction_index);
-        switch (goal_->type_)
+        std::array<float, InteractionStore::tendency_feature_count_> features;
+        size_t feature_index = 0;
+        for (int type_index = 0; type_index < static_cast<int>(ContextType::kLast); ++type_index)
         {
-        case GoalType::kWealth:
-            relevant_effect = interaction_store_.GetWealthEffects(interaction_index)[0];
-            break;
-        case GoalType::kAcceptance:
-            // skip first as we want the values of other people to this actor
-            for (size_t i = 1; i < effects.size(); ++i)
-            {
-                if (effects[i].count(0))
-                {
-                    relevant_effect += effects[i].at(0).at(static_cast<int>(RelationshipType::kFriendship));
-                }
-            }
-            break;
-        case GoalType::kRelationship:
-            // skip first as we want the values of other people to this actor
-            for (size_t i = 1; i < effects.size(); ++i)
-            {
-                // do both sides of the relationship change
-                if (effects[i].count(0) && effects[0].count(i))
-                {
-                    relevant_effect += effects[i].at(0).at(static_cast<int>(RelationshipType::kLove));
-                    relevant_effect += effects[0].at(1).at(static_cast<int>(RelationshipType::kLove));
-                }
-            }
-            break;
-        case GoalType::kHedonism:
-            relevant_effect = interaction_store_.GetEmotionEffects(interaction_index)[0][static_cast<int>(EmotionType::kSatisfied)];
-            break;
-        case GoalType::kPower:
-            // skip first as we want the values of other people to this actor
-            for (const auto &[other_actor, effect] : effects[0])
-            {
-                // using minus here because the actor wants a negative value
-                relevant_effect -= effect.at(static_cast<int>(RelationshipType::kProtective));
-            }
-            if(effects[0].size()>0){
-                relevant_effect /= effects[0].size();
-            }
-            break;
-        case GoalType::kLast:
-            TATTLETALE_ERROR_PRINT(true, "Trying to apply invalid goal type");
-            break;
+            features[feature_index++] = (context == static_cast<ContextType>(type_index) ? 1.0f : -1.0f);
         }
-        relevant_effect = std::clamp(relevant_effect, -1.0f, 1.0f);
+        features[feature_index++] = actor_state_store_.GetWealth(id_);
+        for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+        {
+            features[feature_index++] = actor_state_store_.GetEmotion(id_, type_index);
+        }
+        return features;
+    }
+    float Actor::ApplyGoalChanceModification(float original_chance, size_t interaction_index, Kernel *&out_reason)
+    {
+        GoalType goal_type = actor_state_store_.GetGoalType(id_);
+        TATTLETALE_ERROR_PRINT(goal_type != GoalType::kLast, "Trying to apply invalid goal type");
+        float relevant_effect = interaction_store_.GetGoalEffect(goal_type, interaction_index);
         if (relevant_effect > 0)
         {
             out_reason = goal_;
@@ -433,37 +450,35 @@ namespace tattletale
         return pow(original_chance, (1.0f - relevant_effect));
     }
 
-    void Actor::ApplyWealthChange(const std::vector<Kernel *> &reasons, size_t tick, float value)
+    void Actor::ApplyWealthChange(Kernel *reason, size_t tick, float value)
     {
         if (value == 0)
         {
             return;
         }
-        float previous_value = wealth_->GetValue();
+        float previous_value = actor_state_store_.GetWealth(id_);
         float new_value = std::clamp(previous_value + value, -1.0f, 1.0f);
-        std::vector<Kernel *> all_reasons(reasons);
-        all_reasons.push_back(wealth_);
-        wealth_ = chronicle_.CreateResource("wealth", "wealthy", "poor", tick, this, all_reasons, new_value);
+        std::vector<Kernel *> all_reasons = (reason ? std::vector<Kernel *>{reason, wealth_} : std::vector<Kernel *>{wealth_});
+        SetWealth(chronicle_.CreateResource("wealth", "wealthy", "poor", tick, this, std::move(all_reasons), new_value));
     }
-    void Actor::ApplyEmotionChange(const std::vector<Kernel *> &reasons, size_t tick, int type_index, float value)
+    void Actor::ApplyEmotionChange(Kernel *reason, size_t tick, int type_index, float value)
     {
         if (value == 0)
         {
             return;
         }
-        float previous_value = emotions_[type_index]->GetValue();
+        float previous_value = actor_state_store_.GetEmotion(id_, type_index);
         float new_value = std::clamp(previous_value + value, -1.0f, 1.0f);
-        std::vector<Kernel *> all_reasons(reasons);
-        all_reasons.push_back(emotions_[type_index]);
+        std::vector<Kernel *> all_reasons = (reason ? std::vector<Kernel *>{reason, emotions_[type_index]} : std::vector<Kernel *>{emotions_[type_index]});
         EmotionType type = static_cast<EmotionType>(type_index);
-        emotions_[type_index] = chronicle_.CreateEmotion(type, tick, this, all_reasons, new_value);
+        SetEmotion(chronicle_.CreateEmotion(type, tick, this, std::move(all_reasons), new_value));
     }
-    void Actor::ApplyRelationshipChange(const std::vector<Kernel *> &reasons, size_t tick, size_t actor_id, std::vector<float> change)
+    void Actor::ApplyRelationshipChange(Kernel *reason, size_t tick, size_t actor_id, const float *change)
     {
         bool all_zero = true;
-        for (auto &value : change)
+        for (int type_index = 0; type_index < static_cast<int>(RelationshipType::kLast); ++type_index)
         {
-            if (value != 0)
+            if (change[type_index] != 0)
             {
                 all_zero = false;
             }
@@ -472,17 +487,17 @@ namespace tattletale
         {
             return;
         }
-        bool already_known = relationships_.count(actor_id);
+        bool already_known = relationship_store_.HasRelationship(id_, actor_id);
         auto other_actor = school_.GetActor(actor_id);
-        std::vector<Kernel *> all_reasons;
-        std::vector<Relationship *> relationship(static_cast<int>(RelationshipType::kLast));
-        for (int type_index = 0; type_index < change.size(); ++type_index)
+        std::vector<Relationship *> &relationship = relationship_scratch_;
+        relationship.resize(static_cast<size_t>(RelationshipType::kLast));
+        for (int type_index = 0; type_index < static_cast<int>(RelationshipType::kLast); ++type_index)
         {
             float value = change[type_index];
             RelationshipType type = static_cast<RelationshipType>(type_index);
-            all_reasons.clear();
-            all_reasons.insert(all_reasons.end(), reasons.begin(), reasons.end());
             float previous_value = 0;
+            // every new Relationship gets its own reasons, so they are built in place and moved into it
+            std::vector<Kernel *> all_reasons;
             if (already_known)
             {
                 if (value == 0)
@@ -490,13 +505,18 @@ namespace tattletale
                     relationship[type_index] = relationships_.at(actor_id).at(type_index);
                     continue;
                 }
-                previous_value = relationships_.at(actor_id).at(type_index)->GetValue();
-                all_reasons.push_back(relationships_.at(actor_id).at(type_index));
+                previous_value = relationship_store_.GetRelationship(id_, actor_id)[type_index];
+                Kernel *previous_relationship = relationships_.at(actor_id).at(type_index);
+                all_reasons = (reason ? std::vector<Kernel *>{reason, previous_relationship} : std::vector<Kernel *>{previous_relationship});
+            }
+            else if (reason)
+            {
+                all_reasons = {reason};
             }
             float new_value = std::clamp(previous_value + value, -1.0f, 1.0f);
-            relationship[type_index] = chronicle_.CreateRelationship(type, tick, this, other_actor, all_reasons, new_value);
+            relationship[type_index] = chronicle_.CreateRelationship(type, tick, this, other_actor, std::move(all_reasons), new_value);
         }
-        UpdateRelationship(other_actor, relationship, already_known);
+        UpdateRelationship(other_actor, relationship);
     }
 
     std::string Actor::GetDetailedDescriptionString() const
@@ -520,28 +540,44 @@ namespace tattletale
         return detailed_actor_description;
     }
 
-    const std::list<Actor *> &Actor::GetAllKnownActors() const
+    std::list<Actor *> Actor::GetAllKnownActors() const
     {
-        return known_actors_;
+        std::list<Actor *> known_actors;
+        for (auto &known_actor : known_actors_)
+        {
+            known_actors.push_back(known_actor.actor);
+        }
+        return known_actors;
+    }
+    size_t Actor::GetKnownActorCount() const
+    {
+        return known_actors_.size();
     }
-    std::list<Actor *> Actor::GetFreetimeActorGroup() const
+    const std::list<Actor *> &Actor::GetFreetimeActorGroup()
     {
-        return freetime_group;
+        // resizing keeps the existing nodes, so in a steady state the group is refilled without allocating
+        freetime_actor_group_.resize(std::min(setting_.freetime_actor_count, known_actors_.size()));
+        auto known_actor = known_actors_.begin();
+        for (auto &member : freetime_actor_group_)
+        {
+            member = known_actor->actor;
+            ++known_actor;
+        }
+        return freetime_actor_group_;
     }
 
     void Actor::InitializeRandomWealth(size_t tick)
     {
         std::vector<Kernel *> no_reasons;
-        wealth_ = chronicle_.CreateResource("wealth", "wealthy", "poor", tick, this, no_reasons, random_.GetFloat(-1.0f, 1.0f));
+        SetWealth(chronicle_.CreateResource("wealth", "wealthy", "poor", tick, this, no_reasons, random_.GetFloat(-1.0f, 1.0f)));
     }
     void Actor::InitializeRandomEmotions(size_t tick)
     {
         std::vector<Kernel *> no_reasons;
-        emotions_ = std::vector<Emotion *>(static_cast<int>(EmotionType::kLast));
         for (int type_index = 0; type_index < emotions_.size(); ++type_index)
         {
             EmotionType type = static_cast<EmotionType>(type_index);
-            emotions_[type_index] = chronicle_.CreateEmotion(type, tick, this, no_reasons, random_.GetFloat(-1.0f, 1.0f));
+            SetEmotion(chronicle_.CreateEmotion(type, tick, this, no_reasons, random_.GetFloat(-1.0f, 1.0f)));
         }
     }
     void Actor::InitializeRandomRelationships(size_t tick)
@@ -553,7 +589,7 @@ namespace tattletale
             uint32_t other_actor_id = random_.GetUInt(0, setting_.actor_count - 1);
             auto other_actor = school_.GetActor(other_actor_id);
             size_t tries = 0;
-            while ((other_actor_id == id_ || HasRelationshipWith(other_actor_id) || other_actor->GetAllKnownActors().size() > setting_.desired_max_start_relationships_count) &&
+            while ((other_actor_id == id_ || HasRelationshipWith(other_actor_id) || other_actor->GetKnownActorCount() > setting_.desired_max_start_relationships_count) &&
                    tries < setting_.actor_count)
             {
                 ++tries;
@@ -578,74 +614,57 @@ namespace tattletale
         }
     }
 
-    void Actor::UpdateRelationship(Actor *other_actor, std::vector<Relationship *> relationship, bool already_known)
+    void Actor::UpdateRelationship(Actor *other_actor, const std::vector<Relationship *> &relationship)
     {
+        // assigning to an existing entry reuses its storage
         relationships_[other_actor->id_] = relationship;
+        float values[RelationshipStore::type_count_];
+        for (size_t type_index = 0; type_index < RelationshipStore::type_count_; ++type_index)
+        {
+            values[type_index] = relationship[type_index]->GetValue();
+        }
+        relationship_store_.SetRelationship(id_, other_actor->id_, values);
+        ++state_version_;
         float relationship_strength = CalculateRelationshipStrength(other_actor->id_);
-        bool inserted = false;
-        freetime_group.clear();
-        int count = 0;
-        for (auto it = known_actors_.begin(); it != known_actors_.end(); ++it)
+        auto entry = known_actor_entries_.find(other_actor->id_);
+        if (entry != known_actor_entries_.end())
         {
-            if (CalculateRelationshipStrength((*it)->id_) <= relationship_strength && !inserted)
-            {
-                if (!already_known)
-                {
-                    known_actors_.insert(it, other_actor);
-                    inserted = true;
-                }
-                else
-                {
-                    for (auto other_actor_iterator = known_actors_.begin(); other_actor_iterator != known_actors_.end(); ++other_actor_iterator)
-                    {
-                        if ((*other_actor_iterator)->id_ == other_actor->id_)
-                        {
-                            known_actors_.splice(it, known_actors_, other_actor_iterator);
-                            inserted = true;
-                        }
-                    }
-                }
-                freetime_group.push_back(other_actor);
-            }
-            else
+            if (entry->second->strength == relationship_strength)
             {
-                if (count < setting_.freetime_actor_count)
-                {
-                    freetime_group.push_back(*it);
-                }
+                return;
             }
-            ++count;
-        }
-        if (!inserted && !already_known)
-        {
-            known_actors_.push_back(other_actor);
+            // reinsert the existing node so repositioning does not allocate
+            auto node = known_actors_.extract(entry->second);
+            node.value().strength = relationship_strength;
+            node.value().stamp = known_actor_stamp_++;
+            entry->second = known_actors_.insert(std::move(node)).position;
+            return;
         }
+        known_actor_entries_[other_actor->id_] = known_actors_.insert({relationship_strength, known_actor_stamp_++, other_actor}).first;
     }
     void Actor::InitializeRandomGoal(size_t tick)
     {
         std::vector<Kernel *> no_reasons;
-        goal_ = chronicle_.CreateGoal(Goal::GetRandomGoalType(random_), tick, this, no_reasons);
+        SetGoal(chronicle_.CreateGoal(Goal::GetRandomGoalType(random_), tick, this, no_reasons));
     }
 
     float Actor::CalculateRelationshipStrength(size_t actor_id) const
     {
         float value = 0;
-        for (const auto &relationship : relationships_.at(actor_id))
+        const float *relationship = relationship_store_.GetRelationship(id_, actor_id);
+        if (!relationship)
+        {
+            return value;
+        }
+        for (size_t type_index = 0; type_index < RelationshipStore::type_count_; ++type_index)
         {
-            value += abs(relationship->GetValue());
+            value += abs(relationship[type_index]);
         }
         return value;
     }
 
     bool Actor::HasRelationshipWith(size_t actor_id) const
     {
-        for (auto &[key, value] : relationships_)
-        {
-            if (key == actor_id)
-            {
-                return true;
-            }
-        }
-        return false;
+        return relationship_store_.HasRelationship(id_, actor_id);
     }
 } // namespace tattletale
\ No newline at end of file
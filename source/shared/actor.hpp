@@ -5,10 +5,13 @@
 #include <list>
 #include <memory>
 #include <set>
+#include <cstdint>
 #include <robin_hood.h>
 #include "shared/setting.hpp"
 #include "shared/random.hpp"
 #include "tale/interactionstore.hpp"
+#include "tale/actorstatestore.hpp"
+#include "tale/relationshipstore.hpp"
 #include "shared/kernels/goal.hpp"
 #include "shared/kernels/resourcekernels/resource.hpp"
 #include "shared/kernels/resourcekernels/emotion.hpp"
@@ -44,19 +47,26 @@ namespace tattletale
         const std::string last_name_;
         /**
          * @brief The abstract state of the  \link Actor Actor's \endlink wealth.
+         *
+         * Only kept for provenance, the current value lives in the ActorStateStore. Use SetWealth to change it.
          */
         Resource *wealth_;
         /**
          * @brief The \link Actor Actor's \endlink current \link Emotion Emotional \endlink state is. Maps one Emotion to each EmotionType.
+         *
+         * Only kept for provenance, the current values live in the ActorStateStore. Use SetEmotion to change them.
          */
-        std::vector<Emotion *> emotions_;
+        std::array<Emotion *, static_cast<size_t>(EmotionType::kLast)> emotions_ = {};
         /**
          * @brief Holds the  \link Actor Actor's \endlink \link Relationship Relationships \endlink with other \link Actor Actors \endlink.
          * Maps the other \link Actor Actor's \endlink id to another map of RelationshipType to Relationship.
+         * Only kept for provenance, the current values live in the RelationshipStore.
          */
         robin_hood::unordered_map<size_t, std::vector<Relationship *>> relationships_;
         /**
          * @brief The Goal the Actor is trying to reach during the simulation.
+         *
+         * Only kept for provenance, the GoalType also lives in the ActorStateStore. Use SetGoal to change it.
          */
         Goal *goal_;
 
@@ -67,6 +77,24 @@ namespace tattletale
          * @param tick During which tick this process happens.
          */
         void SetupRandomValues(size_t tick);
+        /**
+         * @brief Sets the wealth Resource of the Actor and writes its value to the ActorStateStore.
+         *
+         * @param wealth The new wealth Resource.
+         */
+        void SetWealth(Resource *wealth);
+        /**
+         * @brief Sets the Emotion of the Actor for the EmotionType of the passed Emotion and writes its value to the ActorStateStore.
+         *
+         * @param emotion The new Emotion.
+         */
+        void SetEmotion(Emotion *emotion);
+        /**
+         * @brief Sets the Goal of the Actor and writes its GoalType to the ActorStateStore.
+         *
+         * @param goal The new Goal.
+         */
+        void SetGoal(Goal *goal);
         /**
          * @brief Checks if the Actor is enrolled in the passed Course.
          *
@@ -182,29 +210,29 @@ namespace tattletale
         /**
          * @brief Applies a change to the \link Actor Actor's \endlink wealth.
          *
-         * @param reasons Vector holding the reasons for this change.
+         * @param reason The Kernel that caused this change, usually an Interaction. Can be nullptr.
          * @param tick The tick during which this change happened.
          * @param value By how much the wealth gets changed.
          */
-        void ApplyWealthChange(const std::vector<Kernel *> &reasons, size_t tick, float value);
+        void ApplyWealthChange(Kernel *reason, size_t tick, float value);
         /**
          * @brief Applies a change to the \link Actor Actor's \endlink \link Emotion Emotional \endlink state.
          *
-         * @param reasons Vector holding the reasons for this change.
+         * @param reason The Kernel that caused this change, usually an Interaction. Can be nullptr.
          * @param tick The tick during which this change happened.
          * @param type_index The type index of the EmotionType of the Emotion that gets changed.
          * @param value By how much the Emotion gets changed.
          */
-        void ApplyEmotionChange(const std::vector<Kernel *> &reasons, size_t tick, int type_index, float value);
+        void ApplyEmotionChange(Kernel *reason, size_t tick, int type_index, float value);
         /**
          * @brief Applies changes to the \link Actor Actor's \endlink \link Relationship Relationships \endlink.
          *
-         * @param reasons Vector holding the reasons for this change.
+         * @param reason The Kernel that caused this change, usually an Interaction. Can be nullptr.
          * @param tick The tick during which this change happened.
          * @param actor_id The id of the Actor with which the Relationship gets changed..
-         * @param change Vector with floats describing by how much each Relationship will be changed.
+         * @param change Pointer to one float per RelationshipType describing by how much each Relationship will be changed.
          */
-        void ApplyRelationshipChange(const std::vector<Kernel *> &reasons, size_t tick, size_t actor_id, std::vector<float> change);
+        void ApplyRelationshipChange(Kernel *reason, size_t tick, size_t actor_id, const float *change);
         /**
          * @brief Creates a string describing the current status of the Actor.
          *
@@ -214,17 +242,27 @@ namespace tattletale
         /**
          * @brief Returns a list of all other \link Actor Actors \endlink this Actor has some kind of Relationship with.
          *
+         * The list is ordered by Relationship strength, strongest first.
+         *
          * @return The list of known \link Actor Actors \endlink.
          */
-        const std::list<Actor *> &GetAllKnownActors() const;
+        std::list<Actor *> GetAllKnownActors() const;
+        /**
+         * @brief Getter for the amount of other \link Actor Actors \endlink this Actor has some kind of Relationship with.
+         *
+         * @return The amount of known \link Actor Actors \endlink.
+         */
+        size_t GetKnownActorCount() const;
         /**
          * @brief Returns a list of \link Actor Actors \endlink this Actor has the strongest Relationship with. The size of this list is determined by the Setting.
          *
          * This group of Actors will be used for Interaction that happen during the freetime of the Actor. This happens because it makes sense for the Actor
          * to interact with those Actors he has the strongest feelings for (be they negative or positive).
+         * Only walks the first entries of the strength ordered known \link Actor Actors \endlink, so it does not depend on how many \link Actor Actors \endlink are known.
+         * The list is kept by the Actor and refilled on every call.
          * @return The list of \link Actor Actors \endlink.
          */
-        std::list<Actor *> GetFreetimeActorGroup() const;
+        const std::list<Actor *> &GetFreetimeActorGroup();
         /**
          * @brief Caluclate the strength of the Relationship for the passed Actor.
          *
@@ -257,6 +295,14 @@ namespace tattletale
          * @brief Holds a Reference to the InteractionStore object of the simulation.
          */
         InteractionStore &interaction_store_;
+        /**
+         * @brief Holds a Reference to the ActorStateStore object of the Chronicle, which outlives the School.
+         */
+        ActorStateStore &actor_state_store_;
+        /**
+         * @brief Holds a Reference to the RelationshipStore object of the Chronicle, which outlives the School.
+         */
+        RelationshipStore &relationship_store_;
         /**
          * @brief Holds a reference to the instance of the Setting object of the simulation.
          */
@@ -270,13 +316,126 @@ namespace tattletale
          */
         std::vector<int> enrolled_courses_id_;
         /**
-         * @brief Holds all other \link Actor Actors \endlink this Actor has some kind of Relationship with.
+         * @brief Entry of a known Actor, ordered by the cached strength of the Relationship with it.
+         */
+        struct KnownActor
+        {
+            /**
+             * @brief The Relationship strength at the time the entry was last updated.
+             */
+            float strength;
+            /**
+             * @brief Increases with every update so that among equally strong \link Relationship Relationships \endlink the most recently changed one comes first.
+             */
+            uint64_t stamp;
+            /**
+             * @brief The known Actor.
+             */
+            Actor *actor;
+            /**
+             * @brief Orders strongest first, then most recently updated first.
+             */
+            bool operator<(const KnownActor &other) const
+            {
+                if (strength != other.strength)
+                {
+                    return strength > other.strength;
+                }
+                return stamp > other.stamp;
+            }
+        };
+        /**
+         * @brief Holds all other \link Actor Actors \endlink this Actor has some kind of Relationship with, strongest Relationship first.
+         */
+        std::set<KnownActor> known_actors_;
+        /**
+         * @brief Maps the id of each known Actor to its entry in known_actors_, so it can be repositioned without searching.
+         */
+        robin_hood::unordered_map<size_t, std::set<KnownActor>::iterator> known_actor_entries_;
+        /**
+         * @brief The stamp the next updated entry of known_actors_ will get.
+         */
+        uint64_t known_actor_stamp_ = 0;
+        /**
+         * @brief Scratch buffer for the tendency chances of the whole catalogue, reused between calls of ChooseInteraction.
          */
-        std::list<Actor *> known_actors_;
+        std::vector<float> tendency_chances_;
         /**
-         * @brief Holds all the \link Actor Actors \endlink this Actor has the strongest Relationships with.
-         * */
-        std::list<Actor *> freetime_group;
+         * @brief Scratch buffer for the bitmask of met emotion requirements, reused between calls of ChooseInteraction.
+         */
+        std::vector<uint64_t> emotion_requirement_mask_;
+        /**
+         * @brief Scratch buffer for the members of the group participants are picked from, reused between calls of ChooseInteraction.
+         */
+        std::vector<Actor *> participant_group_;
+        /**
+         * @brief Scratch buffer for the Relationship values towards each member of participant_group_, nullptr if there is none.
+         */
+        std::vector<const float *> participant_relationships_;
+        /**
+         * @brief Scratch buffer marking the members of participant_group_ that already take part in the Interaction.
+         */
+        std::vector<uint8_t> participant_chosen_;
+        /**
+         * @brief Scratch buffer for the chance of each member of participant_group_ to be picked for the current slot.
+         */
+        std::vector<float> participant_chances_;
+        /**
+         * @brief Scratch buffer for the new \link Relationship Relationships \endlink created by ApplyRelationshipChange.
+         */
+        std::vector<Relationship *> relationship_scratch_;
+        /**
+         * @brief Holds the result of GetFreetimeActorGroup, refilled on every call.
+         */
+        std::list<Actor *> freetime_actor_group_;
+        /**
+         * @brief The possible \link Interaction Interactions \endlink and their chances from the last decision in one ContextType.
+         *
+         * Only depends on the state of the Actor itself, the day and the size of the group, so it can be reused as long as none of those changed.
+         */
+        struct DecisionCache
+        {
+            /**
+             * @brief Wether the cache was filled at least once.
+             */
+            bool valid = false;
+            /**
+             * @brief The state_version_ of the Actor when the cache was filled.
+             */
+            uint64_t state_version = 0;
+            /**
+             * @brief The day during which the cache was filled.
+             */
+            size_t day = 0;
+            /**
+             * @brief The size of the group the cache was filled for.
+             */
+            size_t group_size = 0;
+            /**
+             * @brief The catalogue indices of all \link Interaction Interactions \endlink whose requirements were met.
+             */
+            std::vector<size_t> possible_interaction_indices;
+            /**
+             * @brief The chance of each possible Interaction based on its InteractionTendency only.
+             */
+            std::vector<float> base_chances;
+            /**
+             * @brief The chance of each possible Interaction after the Goal modification.
+             */
+            std::vector<float> chances;
+            /**
+             * @brief How many entries of chances are zero.
+             */
+            uint32_t zero_count = 0;
+        };
+        /**
+         * @brief One DecisionCache per ContextType, ContextType::kLast included.
+         */
+        std::array<DecisionCache, static_cast<size_t>(ContextType::kLast) + 1> decision_caches_;
+        /**
+         * @brief Increases whenever the wealth, an Emotion, the Goal or a Relationship of the Actor changes, which invalidates every DecisionCache.
+         */
+        uint64_t state_version_ = 0;
 
         /**
          * @brief Private Constructor so only Chronicle can create Actors.
@@ -287,6 +446,40 @@ namespace tattletale
          * @param last_name The \link Actor Actor's \endlink last name.
          */
         Actor(School &school, size_t id, std::string first_name, std::string last_name);
+        /**
+         * @brief Collects the current state of the Actor in the feature order of the tendency matrix of the InteractionStore.
+         *
+         * @param context In which context the Interaction would happen.
+         * @return The feature vector.
+         */
+        std::array<float, InteractionStore::tendency_feature_count_> GetTendencyFeatures(ContextType context) const;
+        /**
+         * @brief Checks wether the relationship requirements of an Interaction are met by the \link Actor Actor's \endlink \link Relationship Relationships \endlink.
+         *
+         * @param requirement The InteractionRequirement object containing the necessary requirements to be met.
+         * @return The result of the check.
+         */
+        bool CheckRelationshipRequirements(const InteractionRequirement &requirement) const;
+        /**
+         * @brief Calculates the chance of an Actor to be picked for a participant slot from already looked up Relationship values.
+         *
+         * @param [in] actor_id The id of the Actor for which we want to calculate the chance.
+         * @param [in] relationship The Relationship values towards that Actor, nullptr if there is no Relationship.
+         * @param [in] participant_id The participant id for the slot we are currently picking for.
+         * @param [in] requirement The relevant InteractionRequirement for this picking process.
+         * @param [in] tendency The relevant InteractionTendency for this picking process.
+         * @param [out] out_reason_type_index The index of the RelationshipType that increased the chance the most, -1 if there is none.
+         * @return The chance of the Actor being picked.
+         */
+        float CalculateParticipantChance(size_t actor_id, const float *relationship, size_t participant_id, const InteractionRequirement &requirement, const InteractionTendency &tendency, int &out_reason_type_index) const;
+        /**
+         * @brief Fills a DecisionCache with the possible \link Interaction Interactions \endlink and their chances for the current state of the Actor.
+         *
+         * @param cache The DecisionCache that will be filled.
+         * @param group_size The size of the group the Actor is interacting in.
+         * @param context The ContextType the Interaction will take place in.
+         */
+        void RefreshDecisionCache(DecisionCache &cache, size_t group_size, ContextType context);
         /**
          * @brief Initializes the Wealth member with a random value.
          *
@@ -315,11 +508,12 @@ namespace tattletale
         /**
          * @brief Updates the Relationship of this Actor with another one.
          *
+         * Also moves the other Actor to the position matching the new Relationship strength in known_actors_.
+         *
          * @param other_actor The Actor with which the Relationship was changed.
          * @param relationship The new Relationship values.
-         * @param already_known If the other Actor was already known to this Actor.
          */
-        void UpdateRelationship(Actor *other_actor, std::vector<Relationship *> relationship, bool already_known = false);
+        void UpdateRelationship(Actor *other_actor, const std::vector<Relationship *> &relationship);
         /**
          * @brief Chronicle is a friend so private constructor can be accessed.
          */
@@ -3,14 +3,15 @@
 #include "shared/actor.hpp"
 #include "tale/school.hpp"
 #include <chrono>
+#include <iterator>
 #include <fmt/chrono.h>
 
 namespace tattletale
 {
-    Chronicle::Chronicle(Random &random) : random_(random){};
+    Chronicle::Chronicle(Random &random) : random_(random), relationship_store_(0){};
 
     Chronicle::~Chronicle() { Reset(); }
-    void Chronicle::Reset()
+    void Chronicle::Reset(size_t actor_count)
     {
         for (size_t i = 0; i < actors_.size(); ++i)
         {
@@ -21,43 +22,115 @@ namespace tattletale
             delete all_kernels_[i];
         }
         actors_.clear();
-        kernels_by_actor_.clear();
+        first_kernel_id_by_tick_.clear();
+        spill_tick_horizon_ = 0;
+        spill_writer_.close();
+        spill_writer_.clear();
+        spill_reader_.close();
+        spill_reader_.clear();
+        spill_path_.clear();
+        spill_block_offsets_.clear();
+        spill_block_by_kernel_.clear();
+        spill_frontier_ = 0;
+        pinned_kernel_ids_.clear();
+        spilled_kernel_count_ = 0;
+        spill_horizon_tick_ = 0;
+        original_reason_ids_.clear();
+        spilled_consequence_counts_.clear();
+        interaction_count_behind_horizon_by_actor_.clear();
+        prototype_counts_behind_horizon_by_actor_.clear();
+        spill_cache_.clear();
+        kernel_ids_by_actor_.clear();
+        for (auto &kernel_ids : kernel_ids_by_type_)
+        {
+            kernel_ids.clear();
+        }
+        kernel_ids_by_prototype_.clear();
+        kernel_ids_with_goal_reason_.clear();
+        relationships_by_actor_pair_.clear();
+        interactions_by_chance_.clear();
+        interactions_by_chance_outdated_ = false;
+        interaction_chance_sum_ = 0;
+        interaction_chance_mean_ = 0;
+        interaction_chance_m2_ = 0;
+        interaction_reason_count_sum_ = 0;
+        reason_count_histogram_.clear();
+        consequence_count_histogram_.clear();
+        kernel_counts_by_tick_.clear();
         interactions_by_actor_.clear();
         wealth_by_actor_.clear();
         emotions_by_actor_.clear();
+        prototype_counts_by_actor_.clear();
+        prototype_count_checkpoints_by_actor_.clear();
+        first_interaction_by_prototype_by_actor_.clear();
         all_kernels_.clear();
         all_interactions_.clear();
+        actor_state_store_ = ActorStateStore();
+        relationship_store_ = RelationshipStore(actor_count);
     }
 
     Actor *Chronicle::CreateActor(School &school, std::string first_name, std::string last_name)
     {
         Actor *actor = new Actor(school, actors_.size(), first_name, last_name);
         actors_.push_back(actor);
-        kernels_by_actor_.push_back(std::vector<Kernel *>());
-        emotions_by_actor_.push_back(std::vector<Emotion *>());
+        kernel_ids_by_actor_.emplace_back();
+        emotions_by_actor_.emplace_back();
         wealth_by_actor_.push_back(std::vector<Resource *>());
         interactions_by_actor_.push_back(std::vector<Interaction *>());
+        prototype_counts_by_actor_.emplace_back();
+        prototype_count_checkpoints_by_actor_.emplace_back(1);
+        first_interaction_by_prototype_by_actor_.emplace_back();
+        interaction_count_behind_horizon_by_actor_.push_back(0);
+        prototype_counts_behind_horizon_by_actor_.emplace_back();
         return actor;
     }
     Interaction *Chronicle::CreateInteraction(
-        const std::shared_ptr<InteractionPrototype> prototype,
-        const std::shared_ptr<InteractionRequirement> requirement,
-        const std::shared_ptr<InteractionTendency> tendency,
+        const std::shared_ptr<InteractionPrototype> &prototype,
+        const std::shared_ptr<InteractionRequirement> &requirement,
+        const std::shared_ptr<InteractionTendency> &tendency,
         float chance,
         size_t tick,
         std::vector<Kernel *> reasons,
         std::vector<Actor *> participants)
     {
-        Interaction *interaction = new Interaction(prototype, requirement, tendency, chance, all_kernels_.size(), tick, reasons, participants);
-        for (auto &reason : reasons)
+        // the reasons and participants are moved into the Interaction, so only its own copies are used from here on
+        Interaction *interaction = new Interaction(prototype, requirement, tendency, chance, all_kernels_.size(), tick, std::move(reasons), std::move(participants));
+        AddKernel(interaction);
+        size_t prototype_id = prototype->id;
+        if (prototype_id >= kernel_ids_by_prototype_.size())
         {
-            reason->AddConsequence(interaction);
+            kernel_ids_by_prototype_.resize(prototype_id + 1);
         }
-        all_kernels_.push_back(interaction);
-        for (auto &owner : participants)
+        kernel_ids_by_prototype_[prototype_id].push_back(interaction->id_);
+        interactions_by_chance_outdated_ = true;
+        interaction_chance_sum_ += chance;
+        interaction_reason_count_sum_ += interaction->GetReasons().size();
+        // Welford's online algorithm, so the variance stays numerically stable without keeping every chance around
+        double chance_delta = chance - interaction_chance_mean_;
+        interaction_chance_mean_ += chance_delta / GetKernelAmount(KernelType::kInteraction);
+        interaction_chance_m2_ += chance_delta * (chance - interaction_chance_mean_);
+        for (auto &owner : interaction->GetParticipants())
         {
-            kernels_by_actor_[owner->id_].push_back(interaction);
-            interactions_by_actor_[owner->id_].push_back(interaction);
+            size_t actor_id = owner->id_;
+            kernel_ids_by_actor_[actor_id].push_back(interaction->id_);
+            interactions_by_actor_[actor_id].push_back(interaction);
+
+            auto &counts = prototype_counts_by_actor_[actor_id];
+            auto &first_interactions = first_interaction_by_prototype_by_actor_[actor_id];
+            if (prototype_id >= counts.size())
+            {
+                counts.resize(prototype_id + 1, 0);
+                first_interactions.resize(prototype_id + 1, nullptr);
+            }
+            ++counts[prototype_id];
+            if (!first_interactions[prototype_id])
+            {
+                first_interactions[prototype_id] = interaction;
+            }
+            if ((interaction_count_behind_horizon_by_actor_[actor_id] + interactions_by_actor_[actor_id].size()) % prototype_count_checkpoint_interval_ == 0)
+            {
+                prototype_count_checkpoints_by_actor_[actor_id].push_back(counts);
+            }
         }
         all_interactions_.push_back(interaction);
         if (prototype->id > highest_interaction_id)
@@ -68,73 +141,205 @@ namespace tattletale
     }
     Emotion *Chronicle::CreateEmotion(EmotionType type, size_t tick, Actor *owner, std::vector<Kernel *> reasons, float value)
     {
-        Emotion *emotion = new Emotion(type, all_kernels_.size(), tick, owner, reasons, value);
-        for (auto &reason : reasons)
-        {
-            reason->AddConsequence(emotion);
-        }
-        emotions_by_actor_[owner->id_].push_back(emotion);
-        all_kernels_.push_back(emotion);
-        kernels_by_actor_[owner->id_].push_back(emotion);
+        Emotion *emotion = new Emotion(type, all_kernels_.size(), tick, owner, std::move(reasons), value);
+        emotions_by_actor_[owner->id_][static_cast<size_t>(type)].push_back(emotion);
+        AddKernel(emotion);
+        kernel_ids_by_actor_[owner->id_].push_back(emotion->id_);
         return emotion;
     }
     Relationship *Chronicle::CreateRelationship(RelationshipType type, size_t tick, Actor *owner, Actor *target, std::vector<Kernel *> reasons, float value)
     {
-        Relationship *relationship = new Relationship(type, all_kernels_.size(), tick, owner, target, reasons, value);
-        for (auto &reason : reasons)
-        {
-            reason->AddConsequence(relationship);
-        }
-        all_kernels_.push_back(relationship);
-        kernels_by_actor_[owner->id_].push_back(relationship);
+        Relationship *relationship = new Relationship(type, all_kernels_.size(), tick, owner, target, std::move(reasons), value);
+        AddKernel(relationship);
+        kernel_ids_by_actor_[owner->id_].push_back(relationship->id_);
+        relationships_by_actor_pair_[GetActorPairKey(owner->id_, target->id_)][static_cast<size_t>(type)].push_back(relationship);
         return relationship;
     }
     Resource *Chronicle::CreateResource(std::string name, std::string positive_name_variant, std::string negative_name_variant, size_t tick, Actor *owner, std::vector<Kernel *> reasons, float value)
     {
-        Resource *resource = new Resource(name, positive_name_variant, negative_name_variant, all_kernels_.size(), tick, owner, reasons, value);
-        for (auto &reason : reasons)
-        {
-            reason->AddConsequence(resource);
-        }
-        all_kernels_.push_back(resource);
-        kernels_by_actor_[owner->id_].push_back(resource);
+        Resource *resource = new Resource(std::move(name), std::move(positive_name_variant), std::move(negative_name_variant), all_kernels_.size(), tick, owner, std::move(reasons), value);
+        AddKernel(resource);
+        kernel_ids_by_actor_[owner->id_].push_back(resource->id_);
         wealth_by_actor_[owner->id_].push_back(resource);
         return resource;
     }
     Goal *Chronicle::CreateGoal(GoalType type, size_t tick, Actor *owner, std::vector<Kernel *> reasons)
     {
-        Goal *goal = new Goal(type, all_kernels_.size(), tick, owner, reasons);
+        Goal *goal = new Goal(type, all_kernels_.size(), tick, owner, std::move(reasons));
+        AddKernel(goal);
+        kernel_ids_by_actor_[owner->id_].push_back(goal->id_);
+        return goal;
+    }
+    void Chronicle::AddKernel(Kernel *kernel)
+    {
+        all_kernels_.push_back(kernel);
+        size_t type_index = static_cast<size_t>(kernel->type_);
+        kernel_ids_by_type_[type_index].push_back(kernel->id_);
+        if (kernel->tick_ >= kernel_counts_by_tick_.size())
+        {
+            kernel_counts_by_tick_.resize(kernel->tick_ + 1, KernelTypeCounts());
+            first_kernel_id_by_tick_.resize(kernel->tick_ + 1, kernel->id_);
+        }
+        ++kernel_counts_by_tick_[kernel->tick_][type_index];
+
+        const auto &reasons = kernel->GetReasons();
+        if (reasons.size() >= reason_count_histogram_.size())
+        {
+            reason_count_histogram_.resize(reasons.size() + 1, 0);
+        }
+        ++reason_count_histogram_[reasons.size()];
+        if (consequence_count_histogram_.empty())
+        {
+            consequence_count_histogram_.push_back(0);
+        }
+        ++consequence_count_histogram_[0];
+        bool has_goal_reason = false;
         for (auto &reason : reasons)
         {
-            reason->AddConsequence(goal);
+            reason->AddConsequence(kernel);
+            // the reason moves one bucket up in the fan-out histogram
+            size_t consequence_count = reason->GetConsequences().size();
+            if (!spilled_consequence_counts_.empty())
+            {
+                auto spilled_consequence_count = spilled_consequence_counts_.find(reason->id_);
+                if (spilled_consequence_count != spilled_consequence_counts_.end())
+                {
+                    consequence_count += spilled_consequence_count->second;
+                }
+            }
+            if (consequence_count >= consequence_count_histogram_.size())
+            {
+                consequence_count_histogram_.push_back(0);
+            }
+            --consequence_count_histogram_[consequence_count - 1];
+            ++consequence_count_histogram_[consequence_count];
+            has_goal_reason = has_goal_reason || reason->type_ == KernelType::kGoal;
+        }
+        if (has_goal_reason)
+        {
+            kernel_ids_with_goal_reason_.push_back(kernel->id_);
         }
-        all_kernels_.push_back(goal);
-        kernels_by_actor_[owner->id_].push_back(goal);
-        return goal;
     }
 
-    float Chronicle::GetAverageInteractionChance() const
+    std::vector<Kernel *> Chronicle::FindKernels(const KernelQuery &query) const
     {
-        float sum = 0;
-        for (auto interaction : all_interactions_)
+        std::vector<Kernel *> kernels;
+        auto first_kernel_id_of_tick = [this](size_t tick)
+        { return (tick < first_kernel_id_by_tick_.size() ? first_kernel_id_by_tick_[tick] : all_kernels_.size()); };
+        size_t begin_id = first_kernel_id_of_tick(query.first_tick);
+        size_t end_id = (query.last_tick == SIZE_MAX ? all_kernels_.size() : first_kernel_id_of_tick(query.last_tick + 1));
+        if (begin_id >= end_id)
         {
-            sum += interaction->chance_;
+            return kernels;
         }
-        return (sum / all_interactions_.size());
+
+        std::vector<const std::vector<size_t> *> posting_lists;
+        if (query.type != KernelType::kLast)
+        {
+            posting_lists.push_back(&kernel_ids_by_type_[static_cast<size_t>(query.type)]);
+        }
+        if (query.actor_id != KernelQuery::any_)
+        {
+            if (query.actor_id >= kernel_ids_by_actor_.size())
+            {
+                return kernels;
+            }
+            posting_lists.push_back(&kernel_ids_by_actor_[query.actor_id]);
+        }
+        if (query.prototype_id != KernelQuery::any_)
+        {
+            if (query.prototype_id >= kernel_ids_by_prototype_.size())
+            {
+                return kernels;
+            }
+            posting_lists.push_back(&kernel_ids_by_prototype_[query.prototype_id]);
+        }
+        if (posting_lists.empty())
+        {
+            std::copy_if(all_kernels_.begin() + begin_id, all_kernels_.begin() + end_id, std::back_inserter(kernels), [](const Kernel *kernel)
+                         { return kernel != nullptr; });
+            return kernels;
+        }
+
+        // walk the shortest list and only search forward in the others, since all lists are sorted
+        std::sort(posting_lists.begin(), posting_lists.end(), [](const std::vector<size_t> *a, const std::vector<size_t> *b)
+                  { return a->size() < b->size(); });
+        std::vector<std::vector<size_t>::const_iterator> cursors;
+        for (auto posting_list : posting_lists)
+        {
+            cursors.push_back(std::lower_bound(posting_list->begin(), posting_list->end(), begin_id));
+        }
+        const std::vector<size_t> &shortest = *posting_lists[0];
+        for (auto it = cursors[0]; it != shortest.end() && *it < end_id; ++it)
+        {
+            size_t kernel_id = *it;
+            bool in_every_list = true;
+            for (size_t i = 1; i < posting_lists.size() && in_every_list; ++i)
+            {
+                cursors[i] = std::lower_bound(cursors[i], posting_lists[i]->end(), kernel_id);
+                if (cursors[i] == posting_lists[i]->end())
+                {
+                    return kernels;
+                }
+                in_every_list = (*cursors[i] == kernel_id);
+            }
+            if (in_every_list && all_kernels_[kernel_id])
+            {
+                kernels.push_back(all_kernels_[kernel_id]);
+            }
+        }
+        return kernels;
+    }
+
+    float Chronicle::GetAverageInteractionChance() const
+    {
+        return (interaction_chance_sum_ / GetKernelAmount(KernelType::kInteraction));
     }
     float Chronicle::GetAverageInteractionReasonCount() const
     {
-        float sum = 0;
-        int count = 0;
-        for (auto interaction : all_interactions_)
+        return (interaction_reason_count_sum_ / GetKernelAmount(KernelType::kInteraction));
+    }
+    float Chronicle::GetInteractionChanceVariance() const
+    {
+        size_t interaction_count = GetKernelAmount(KernelType::kInteraction);
+        if (interaction_count < 2)
         {
-            if (interaction->GetReasons().size() == 0)
+            return 0.0f;
+        }
+        return static_cast<float>(interaction_chance_m2_ / (interaction_count - 1));
+    }
+    size_t Chronicle::GetKernelAmount(KernelType type) const
+    {
+        return kernel_ids_by_type_[static_cast<size_t>(type)].size();
+    }
+    const std::vector<size_t> &Chronicle::GetReasonCountHistogram() const
+    {
+        return reason_count_histogram_;
+    }
+    const std::vector<size_t> &Chronicle::GetConsequenceCountHistogram() const
+    {
+        return consequence_count_histogram_;
+    }
+    const std::vector<Chronicle::KernelTypeCounts> &Chronicle::GetKernelCountsPerTick() const
+    {
+        return kernel_counts_by_tick_;
+    }
+    std::string Chronicle::GetKernelCountsPerTickDescription() const
+    {
+        std::string description = "tick";
+        for (size_t type_index = 0; type_index < static_cast<size_t>(KernelType::kLast); ++type_index)
+        {
+            description += fmt::format(",{}", static_cast<KernelType>(type_index));
+        }
+        for (size_t tick = 0; tick < kernel_counts_by_tick_.size(); ++tick)
+        {
+            description += fmt::format("\n{}", tick);
+            for (auto count : kernel_counts_by_tick_[tick])
             {
-                count++;
+                description += fmt::format(",{}", count);
             }
-            sum += interaction->GetReasons().size();
         }
-        return (sum / all_interactions_.size());
+        return description;
     }
 
     std::string Chronicle::GetKnownActorsDescription(size_t actor_id) const
@@ -155,11 +360,15 @@ namespace tattletale
 
     std::string Chronicle::GetRandomCausalityChainDescription(size_t depth) const
     {
-        if (all_kernels_.size() <= 0)
+        if (all_kernels_.size() <= spilled_kernel_count_)
         {
             return "";
         }
-        auto kernel = all_kernels_[random_.GetUInt(0, all_kernels_.size() - 1)];
+        Kernel *kernel = nullptr;
+        while (!kernel)
+        {
+            kernel = all_kernels_[random_.GetUInt(0, all_kernels_.size() - 1)];
+        }
         return GetRecursiveKernelDescription(kernel, 0, depth);
     }
 
@@ -169,14 +378,24 @@ namespace tattletale
         {
             return "";
         }
+        // every interaction of a prototype shares its name, so only the first one of each prototype needs to be compared
         std::vector<Kernel *> possible_kernels;
-        for (auto kernel : all_kernels_)
+        KernelQuery query;
+        for (size_t prototype_id = 0; prototype_id < kernel_ids_by_prototype_.size(); ++prototype_id)
         {
-            if (kernel->name_ == "Kiss successfully")
+            const auto &kernel_ids = kernel_ids_by_prototype_[prototype_id];
+            auto first_resident_id = std::find_if(kernel_ids.begin(), kernel_ids.end(), [this](size_t kernel_id)
+                                                  { return all_kernels_[kernel_id] != nullptr; });
+            if (first_resident_id == kernel_ids.end() || all_kernels_[*first_resident_id]->name_ != "Kiss successfully")
             {
-                possible_kernels.push_back(kernel);
+                continue;
             }
+            query.prototype_id = prototype_id;
+            const auto &kisses = FindKernels(query);
+            possible_kernels.insert(possible_kernels.end(), kisses.begin(), kisses.end());
         }
+        std::sort(possible_kernels.begin(), possible_kernels.end(), [](const Kernel *a, const Kernel *b)
+                  { return a->id_ < b->id_; });
         if (possible_kernels.size() > 0)
         {
             auto kernel = possible_kernels[random_.GetUInt(0, possible_kernels.size() - 1)];
@@ -191,104 +410,96 @@ namespace tattletale
         {
             return "No Actor of this ID exists.";
         }
-        auto &kernels = kernels_by_actor_[id];
-        if (kernels.size() <= 0)
+        if (kernel_ids_by_actor_[id].size() <= 0)
         {
             return "No Kernels were created for this ID.";
         }
         std::string description = fmt::format("Interactions for {}", *actors_[id]);
-        for (size_t i = 0; i < kernels.size(); ++i)
+        KernelQuery query;
+        query.type = KernelType::kInteraction;
+        query.actor_id = id;
+        for (auto &interaction : FindKernels(query))
         {
-            if (dynamic_cast<Interaction *>(kernels[i]))
-            {
-                description += fmt::format("\n{}", *kernels[i]);
-            }
+            description += fmt::format("\n{}", *interaction);
         }
         return description;
     }
 
     Interaction *Chronicle::FindUnlikeliestInteraction(size_t tick_cutoff) const
     {
-        Interaction *unlikeliest_interaction(nullptr);
-        for (auto &interaction : all_interactions_)
+        if (interactions_by_chance_outdated_)
         {
-            if (interaction->tick_ > tick_cutoff)
-            {
-                break;
-            }
-            if (interaction->GetReasons().size() > 0)
+            interactions_by_chance_ = all_interactions_;
+            std::sort(interactions_by_chance_.begin(), interactions_by_chance_.end(), [](const Interaction *a, const Interaction *b)
+                      { return (a->chance_ != b->chance_ ? a->chance_ < b->chance_ : a->id_ < b->id_); });
+            interactions_by_chance_outdated_ = false;
+        }
+        for (auto &interaction : interactions_by_chance_)
+        {
+            // reasons that were spilled to disk still count
+            if (interaction->tick_ <= tick_cutoff && (interaction->GetReasons().size() > 0 || original_reason_ids_.count(interaction->id_) > 0))
             {
-                if (!unlikeliest_interaction)
-                {
-                    unlikeliest_interaction = interaction;
-                }
-                else
-                {
-                    if (interaction->chance_ < unlikeliest_interaction->chance_)
-                    {
-                        unlikeliest_interaction = interaction;
-                    }
-                }
+                return interaction;
             }
         }
-        return unlikeliest_interaction;
+        return nullptr;
     }
     Interaction *Chronicle::FindMostOccuringInteractionPrototypeForActorBeforeTick(size_t actor_id, size_t tick) const
     {
-        std::vector<size_t> occurences(highest_interaction_id + 1);
-        for (auto &interaction : interactions_by_actor_[actor_id])
+        if (tick < spill_horizon_tick_)
         {
-            if (interaction->tick_ < tick)
-            {
-                occurences[interaction->GetPrototype()->id] += 1;
-            }
-            else
-            {
-                break;
-            }
+            // the interactions behind the horizon are only counted as a whole, which is too much for earlier ticks
+            return nullptr;
+        }
+        // start from the last checkpoint before the tick and only count the interactions after it one by one
+        const auto &interactions = interactions_by_actor_[actor_id];
+        auto end = std::lower_bound(interactions.begin(), interactions.end(), tick, [](const Interaction *interaction, size_t value)
+                                    { return interaction->tick_ < value; });
+        // interactions_by_actor_ only holds the interactions since the horizon, the ones behind it came before them
+        size_t behind_horizon_count = interaction_count_behind_horizon_by_actor_[actor_id];
+        size_t interaction_count = behind_horizon_count + (end - interactions.begin());
+        size_t checkpoint_index = interaction_count / prototype_count_checkpoint_interval_;
+        size_t checkpoint_position = checkpoint_index * prototype_count_checkpoint_interval_;
+        const auto &checkpoint = (checkpoint_position >= behind_horizon_count ? prototype_count_checkpoints_by_actor_[actor_id][checkpoint_index] : prototype_counts_behind_horizon_by_actor_[actor_id]);
+        auto &occurences = prototype_occurence_scratch_;
+        occurences.assign(highest_interaction_id + 1, 0);
+        std::copy(checkpoint.begin(), checkpoint.end(), occurences.begin());
+        for (auto it = interactions.begin() + (std::max(checkpoint_position, behind_horizon_count) - behind_horizon_count); it != end; ++it)
+        {
+            occurences[(*it)->GetPrototype()->id] += 1;
         }
+        // ties go to the lowest prototype id
         size_t highest = 0;
+        size_t highest_count = 0;
         for (size_t i = 1; i < occurences.size(); ++i)
         {
-            if (occurences[i] > highest)
+            if (occurences[i] > highest_count)
             {
                 highest = i;
+                highest_count = occurences[i];
             }
         }
-        for (auto &interaction : interactions_by_actor_[actor_id])
+        const auto &first_interactions = first_interaction_by_prototype_by_actor_[actor_id];
+        if (highest >= first_interactions.size())
         {
-            auto prototype = interaction->GetPrototype();
-            if (prototype->id == highest)
-            {
-                return interaction;
-            };
+            return nullptr;
         }
-        return nullptr;
+        // first interactions are pinned, so they are never spilled
+        return first_interactions[highest];
     }
     
     ActorStatus Chronicle::FindActorStatusDuringTick(size_t actor_id, size_t tick) const{
-        std::vector<Emotion*> emotions (static_cast<int>(EmotionType::kLast), nullptr);
-        Resource* wealth= nullptr;
-        Goal* goal = actors_[actor_id]->goal_;
         if(tick ==0){
             tick=1;
         }
-        for(auto& kernel : kernels_by_actor_[actor_id]){
-            if(kernel->tick_>=tick){
-                break;
-            }
-            if(kernel->type_==KernelType::kResource){
-                wealth = dynamic_cast<Resource*>(kernel);
-            }
-            if(kernel->type_==KernelType::kEmotion){
-                Emotion* emotion = dynamic_cast<Emotion*>(kernel);
-                emotions[static_cast<int>(emotion->GetType())]=emotion;
-            }
-        }
         ActorStatus status;
-        status.goal=goal;
-        status.wealth=wealth;
-        status.emotions = emotions;
+        status.goal = actors_[actor_id]->goal_;
+        status.wealth = GetLastWealth(tick, actor_id);
+        status.emotions.resize(static_cast<size_t>(EmotionType::kLast));
+        for (size_t type_index = 0; type_index < status.emotions.size(); ++type_index)
+        {
+            status.emotions[type_index] = FindLastBeforeTick(emotions_by_actor_[actor_id][type_index], tick);
+        }
         return status;
     }
     size_t Chronicle::RecursivelyFindHighestAbsoluteInterestChain(Kernel *kernel, size_t current_depth, size_t max_depth, std::vector<Kernel *> &out_chain) const
@@ -336,7 +547,10 @@ namespace tattletale
         #endif //TATTLETALE_PROGRESS_PRINT_OUTPUT
         for (auto &kernel : all_kernels_)
         {
-            
+            if (!kernel)
+            {
+                continue;
+            }
         #ifdef TATTLETALE_PROGRESS_PRINT_OUTPUT
             ++count;
             if (count >= 100 || kernel->id_ == kernel_amount - 1)
@@ -424,38 +638,32 @@ namespace tattletale
     }
     size_t Chronicle::GetLastTick() const
     {
-        return all_kernels_.back()->tick_;
+        return (first_kernel_id_by_tick_.empty() ? 0 : first_kernel_id_by_tick_.size() - 1);
     }
     Emotion *Chronicle::GetLastEmotionOfType(size_t tick, size_t actor_id, EmotionType type) const
     {
-        Emotion *last_emotion = nullptr;
-        for (auto &emotion : emotions_by_actor_[actor_id])
-        {
-            if (emotion->type_ != type)
-            {
-                continue;
-            }
-            if (emotion->tick_ >= tick)
-            {
-                break;
-            }
-            last_emotion = emotion;
-        }
-        return last_emotion;
+        return FindLastBeforeTick(emotions_by_actor_[actor_id][static_cast<size_t>(type)], tick);
     }
 
     Resource *Chronicle::GetLastWealth(size_t tick, size_t actor_id) const
     {
-        Resource *last_wealth = nullptr;
-        for (auto &wealth : wealth_by_actor_[actor_id])
+        return FindLastBeforeTick(wealth_by_actor_[actor_id], tick);
+    }
+
+    const std::vector<Relationship *> &Chronicle::GetRelationshipTimeline(size_t owner_id, size_t target_id, RelationshipType type) const
+    {
+        static const std::vector<Relationship *> empty_timeline;
+        auto it = relationships_by_actor_pair_.find(GetActorPairKey(owner_id, target_id));
+        if (it == relationships_by_actor_pair_.end())
         {
-            if (wealth->tick_ >= tick)
-            {
-                break;
-            }
-            last_wealth = wealth;
+            return empty_timeline;
         }
-        return last_wealth;
+        return it->second[static_cast<size_t>(type)];
+    }
+
+    Relationship *Chronicle::GetLastRelationshipOfType(size_t tick, size_t owner_id, size_t target_id, RelationshipType type) const
+    {
+        return FindLastBeforeTick(GetRelationshipTimeline(owner_id, target_id, type), tick);
     }
 
     std::string Chronicle::GetGoalCausalityChainDescription(size_t depth) const
@@ -464,21 +672,9 @@ namespace tattletale
         {
             return "";
         }
-        std::vector<Kernel *> possible_kernels;
-        for (auto kernel : all_kernels_)
+        if (kernel_ids_with_goal_reason_.size() > 0)
         {
-            for (auto reason : kernel->GetReasons())
-            {
-                if (dynamic_cast<Goal *>(reason))
-                {
-                    possible_kernels.push_back(kernel);
-                    break;
-                }
-            }
-        }
-        if (possible_kernels.size() > 0)
-        {
-            auto kernel = possible_kernels[random_.GetUInt(0, possible_kernels.size() - 1)];
+            auto kernel = all_kernels_[kernel_ids_with_goal_reason_[random_.GetUInt(0, kernel_ids_with_goal_reason_.size() - 1)]];
             return GetRecursiveKernelDescription(kernel, 0, depth);
         }
         return "Did not find a kernel with a goal as reason.";
@@ -518,4 +714,426 @@ namespace tattletale
     {
         return random_;
     }
+
+    ActorStateStore &Chronicle::GetActorStateStore()
+    {
+        return actor_state_store_;
+    }
+
+    RelationshipStore &Chronicle::GetRelationshipStore()
+    {
+        return relationship_store_;
+    }
+
+    bool Chronicle::EnableSpilling(const std::string &path, size_t tick_horizon)
+    {
+        TATTLETALE_ERROR_PRINT(spilled_kernel_count_ == 0, "Spilling has to be enabled before any Kernel was spilled");
+        spill_writer_.close();
+        spill_writer_.clear();
+        spill_writer_.open(path, std::ios::binary | std::ios::trunc);
+        if (!spill_writer_)
+        {
+            spill_tick_horizon_ = 0;
+            return false;
+        }
+        spill_path_ = path;
+        spill_tick_horizon_ = tick_horizon;
+        return true;
+    }
+
+    void Chronicle::SpillOldKernels(size_t current_tick)
+    {
+        if (spill_tick_horizon_ == 0 || current_tick <= spill_tick_horizon_)
+        {
+            return;
+        }
+        size_t cutoff_tick = current_tick - spill_tick_horizon_;
+        size_t end_id = (cutoff_tick < first_kernel_id_by_tick_.size() ? first_kernel_id_by_tick_[cutoff_tick] : all_kernels_.size());
+        // every interaction behind the horizon moves into the counts behind the horizon, no matter wether it gets spilled or pinned
+        std::vector<size_t> touched_actor_ids;
+        for (size_t kernel_id = spill_frontier_; kernel_id < end_id; ++kernel_id)
+        {
+            Kernel *kernel = all_kernels_[kernel_id];
+            if (kernel->type_ != KernelType::kInteraction)
+            {
+                continue;
+            }
+            size_t prototype_id = dynamic_cast<Interaction *>(kernel)->GetPrototype()->id;
+            for (auto participant : dynamic_cast<Interaction *>(kernel)->GetParticipants())
+            {
+                size_t actor_id = participant->id_;
+                touched_actor_ids.push_back(actor_id);
+                ++interaction_count_behind_horizon_by_actor_[actor_id];
+                auto &counts = prototype_counts_behind_horizon_by_actor_[actor_id];
+                if (prototype_id >= counts.size())
+                {
+                    counts.resize(prototype_id + 1, 0);
+                }
+                ++counts[prototype_id];
+            }
+        }
+        std::sort(touched_actor_ids.begin(), touched_actor_ids.end());
+        touched_actor_ids.erase(std::unique(touched_actor_ids.begin(), touched_actor_ids.end()), touched_actor_ids.end());
+        for (auto actor_id : touched_actor_ids)
+        {
+            auto &interactions = interactions_by_actor_[actor_id];
+            interactions.erase(interactions.begin(), std::lower_bound(interactions.begin(), interactions.end(), cutoff_tick, [](const Interaction *interaction, size_t value)
+                                                                      { return interaction->tick_ < value; }));
+            // checkpoints before the first interaction in the timeline are never read again, the counts behind the horizon replace them
+            auto &checkpoints = prototype_count_checkpoints_by_actor_[actor_id];
+            for (size_t checkpoint_index = 0; checkpoint_index * prototype_count_checkpoint_interval_ < interaction_count_behind_horizon_by_actor_[actor_id] && checkpoint_index < checkpoints.size(); ++checkpoint_index)
+            {
+                std::vector<uint32_t>().swap(checkpoints[checkpoint_index]);
+            }
+        }
+        spill_horizon_tick_ = cutoff_tick;
+
+        // the pinned kernels come first, so the candidates stay sorted by id
+        std::vector<size_t> candidate_ids;
+        candidate_ids.swap(pinned_kernel_ids_);
+        for (size_t kernel_id = spill_frontier_; kernel_id < end_id; ++kernel_id)
+        {
+            candidate_ids.push_back(kernel_id);
+        }
+        spill_frontier_ = std::max(spill_frontier_, end_id);
+        std::vector<Kernel *> spilled_kernels;
+        for (auto kernel_id : candidate_ids)
+        {
+            Kernel *kernel = all_kernels_[kernel_id];
+            if (IsPinned(kernel, cutoff_tick))
+            {
+                pinned_kernel_ids_.push_back(kernel_id);
+            }
+            else
+            {
+                spilled_kernels.push_back(kernel);
+            }
+        }
+        if (spilled_kernels.empty())
+        {
+            return;
+        }
+
+        uint32_t block_index = static_cast<uint32_t>(spill_block_offsets_.size());
+        spill_block_by_kernel_.resize(all_kernels_.size(), MappedChronicle::no_id_);
+        for (auto kernel : spilled_kernels)
+        {
+            spill_block_by_kernel_[kernel->id_] = block_index;
+        }
+        WriteSpillBlock(spilled_kernels);
+
+        // remember what the resident kernels lose before any link gets cut
+        for (auto kernel : spilled_kernels)
+        {
+            for (auto consequence : kernel->GetConsequences())
+            {
+                if (!IsSpilled(consequence->id_) && original_reason_ids_.find(consequence->id_) == original_reason_ids_.end())
+                {
+                    original_reason_ids_[consequence->id_] = GetReasonIds(consequence);
+                }
+            }
+            for (auto reason : kernel->GetReasons())
+            {
+                if (!IsSpilled(reason->id_))
+                {
+                    ++spilled_consequence_counts_[reason->id_];
+                }
+            }
+        }
+        auto is_spilled = [this](size_t kernel_id)
+        { return IsSpilled(kernel_id); };
+        for (auto kernel : spilled_kernels)
+        {
+            for (auto consequence : kernel->GetConsequences())
+            {
+                if (!IsSpilled(consequence->id_))
+                {
+                    consequence->RemoveLinks(is_spilled);
+                }
+            }
+            for (auto reason : kernel->GetReasons())
+            {
+                if (!IsSpilled(reason->id_))
+                {
+                    reason->RemoveLinks(is_spilled);
+                }
+            }
+        }
+
+        auto remove_spilled = [this](auto &timeline)
+        {
+            timeline.erase(std::remove_if(timeline.begin(), timeline.end(), [this](const Kernel *kernel)
+                                          { return IsSpilled(kernel->id_); }),
+                           timeline.end());
+        };
+        // collect every touched timeline first so each one only gets compacted once, no matter how many of its kernels were spilled
+        std::vector<std::vector<Emotion *> *> touched_emotion_timelines;
+        std::vector<std::vector<Resource *> *> touched_wealth_timelines;
+        std::vector<std::vector<Relationship *> *> touched_relationship_timelines;
+        for (auto kernel : spilled_kernels)
+        {
+            size_t owner_id = kernel->GetOwner()->id_;
+            switch (kernel->type_)
+            {
+            case KernelType::kEmotion:
+                touched_emotion_timelines.push_back(&emotions_by_actor_[owner_id][static_cast<size_t>(dynamic_cast<Emotion *>(kernel)->GetType())]);
+                break;
+            case KernelType::kResource:
+                touched_wealth_timelines.push_back(&wealth_by_actor_[owner_id]);
+                break;
+            case KernelType::kRelationship:
+            {
+                Relationship *relationship = dynamic_cast<Relationship *>(kernel);
+                touched_relationship_timelines.push_back(&relationships_by_actor_pair_[GetActorPairKey(owner_id, relationship->target_->id_)][static_cast<size_t>(relationship->GetType())]);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+        auto compact_touched = [&remove_spilled](auto &timelines)
+        {
+            std::sort(timelines.begin(), timelines.end());
+            timelines.erase(std::unique(timelines.begin(), timelines.end()), timelines.end());
+            for (auto timeline : timelines)
+            {
+                remove_spilled(*timeline);
+            }
+        };
+        compact_touched(touched_emotion_timelines);
+        compact_touched(touched_wealth_timelines);
+        compact_touched(touched_relationship_timelines);
+        remove_spilled(all_interactions_);
+        interactions_by_chance_.clear();
+        interactions_by_chance_outdated_ = true;
+        kernel_ids_with_goal_reason_.erase(std::remove_if(kernel_ids_with_goal_reason_.begin(), kernel_ids_with_goal_reason_.end(), is_spilled), kernel_ids_with_goal_reason_.end());
+
+        for (auto kernel : spilled_kernels)
+        {
+            original_reason_ids_.erase(kernel->id_);
+            spilled_consequence_counts_.erase(kernel->id_);
+            all_kernels_[kernel->id_] = nullptr;
+            delete kernel;
+        }
+        spilled_kernel_count_ += spilled_kernels.size();
+    }
+
+    size_t Chronicle::GetSpilledKernelAmount() const
+    {
+        return spilled_kernel_count_;
+    }
+
+    size_t Chronicle::GetSpillHorizonTick() const
+    {
+        return spill_horizon_tick_;
+    }
+
+    bool Chronicle::IsSpilled(size_t kernel_id) const
+    {
+        return (kernel_id < spill_block_by_kernel_.size() && spill_block_by_kernel_[kernel_id] != MappedChronicle::no_id_);
+    }
+
+    SpilledKernel Chronicle::GetSpilledKernel(size_t kernel_id) const
+    {
+        TATTLETALE_ERROR_PRINT(IsSpilled(kernel_id), fmt::format("Kernel {} was not spilled", kernel_id));
+        size_t block_index = spill_block_by_kernel_[kernel_id];
+        auto cached_block = std::find_if(spill_cache_.begin(), spill_cache_.end(), [block_index](const SpillBlock &block)
+                                         { return block.index == block_index; });
+        if (cached_block != spill_cache_.end())
+        {
+            spill_cache_.splice(spill_cache_.begin(), spill_cache_, cached_block);
+        }
+        else
+        {
+            spill_cache_.push_front(ReadSpillBlock(block_index));
+            if (spill_cache_.size() > spill_cache_capacity_)
+            {
+                spill_cache_.pop_back();
+            }
+        }
+        const auto &kernels = spill_cache_.front().kernels;
+        auto spilled_kernel = std::lower_bound(kernels.begin(), kernels.end(), kernel_id, [](const SpilledKernel &kernel, size_t id)
+                                               { return kernel.id < id; });
+        return *spilled_kernel;
+    }
+
+    void Chronicle::ForEachKernel(const std::function<void(const SpilledKernel &)> &function) const
+    {
+        // the blocks whose first kernel was visited but not their last one, each with the position of its next kernel
+        robin_hood::unordered_node_map<size_t, std::pair<SpillBlock, size_t>> open_blocks;
+        SpilledKernel resident_kernel;
+        for (size_t kernel_id = 0; kernel_id < all_kernels_.size(); ++kernel_id)
+        {
+            if (IsSpilled(kernel_id))
+            {
+                // the kernels of a block are sorted by id, so the next one of its block is always the one with this id
+                size_t block_index = spill_block_by_kernel_[kernel_id];
+                auto open_block = open_blocks.find(block_index);
+                if (open_block == open_blocks.end())
+                {
+                    open_block = open_blocks.emplace(block_index, std::make_pair(ReadSpillBlock(block_index), size_t(0))).first;
+                }
+                auto &[block, next_index] = open_block->second;
+                function(block.kernels[next_index]);
+                if (++next_index == block.kernels.size())
+                {
+                    open_blocks.erase(open_block);
+                }
+                continue;
+            }
+            Kernel *kernel = all_kernels_[kernel_id];
+            resident_kernel.id = kernel_id;
+            resident_kernel.record = MappedChronicle::CreateKernelRecord(kernel, 0);
+            resident_kernel.name = kernel->name_;
+            resident_kernel.reason_ids = GetReasonIds(kernel);
+            resident_kernel.participant_ids.clear();
+            for (auto participant : kernel->GetAllParticipants())
+            {
+                resident_kernel.participant_ids.push_back(participant->id_);
+            }
+            function(resident_kernel);
+        }
+    }
+
+    std::vector<size_t> Chronicle::GetReasonIds(const Kernel *kernel) const
+    {
+        auto original_reason_ids = original_reason_ids_.find(kernel->id_);
+        if (original_reason_ids != original_reason_ids_.end())
+        {
+            return original_reason_ids->second;
+        }
+        std::vector<size_t> reason_ids;
+        for (auto reason : kernel->GetReasons())
+        {
+            reason_ids.push_back(reason->id_);
+        }
+        return reason_ids;
+    }
+
+    bool Chronicle::IsPinned(Kernel *kernel, size_t horizon_tick) const
+    {
+        size_t owner_id = kernel->GetOwner()->id_;
+        auto is_current_or_horizon_state = [kernel, horizon_tick](const auto &timeline)
+        {
+            return (timeline.back() == kernel || FindLastBeforeTick(timeline, horizon_tick) == kernel);
+        };
+        switch (kernel->type_)
+        {
+        case KernelType::kEmotion:
+            return is_current_or_horizon_state(emotions_by_actor_[owner_id][static_cast<size_t>(dynamic_cast<Emotion *>(kernel)->GetType())]);
+        case KernelType::kResource:
+            return is_current_or_horizon_state(wealth_by_actor_[owner_id]);
+        case KernelType::kRelationship:
+        {
+            Relationship *relationship = dynamic_cast<Relationship *>(kernel);
+            return is_current_or_horizon_state(GetRelationshipTimeline(owner_id, relationship->target_->id_, relationship->GetType()));
+        }
+        case KernelType::kGoal:
+            return (actors_[owner_id]->goal_ == kernel);
+        case KernelType::kInteraction:
+        {
+            Interaction *interaction = dynamic_cast<Interaction *>(kernel);
+            size_t prototype_id = interaction->GetPrototype()->id;
+            for (auto participant : interaction->GetParticipants())
+            {
+                if (first_interaction_by_prototype_by_actor_[participant->id_][prototype_id] == interaction)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        default:
+            return false;
+        }
+    }
+
+    void Chronicle::WriteSpillBlock(const std::vector<Kernel *> &kernels)
+    {
+        std::vector<uint64_t> ids;
+        std::vector<MappedChronicle::KernelRecord> records;
+        std::vector<uint32_t> reason_offsets = {0};
+        std::vector<uint32_t> reason_ids;
+        std::vector<uint32_t> participant_offsets = {0};
+        std::vector<uint32_t> participant_ids;
+        std::vector<char> strings;
+        robin_hood::unordered_map<std::string, uint32_t> string_offsets;
+        for (auto kernel : kernels)
+        {
+            auto string_offset = string_offsets.emplace(kernel->name_, static_cast<uint32_t>(strings.size()));
+            if (string_offset.second)
+            {
+                strings.insert(strings.end(), kernel->name_.begin(), kernel->name_.end());
+                strings.push_back('\0');
+            }
+            ids.push_back(kernel->id_);
+            records.push_back(MappedChronicle::CreateKernelRecord(kernel, string_offset.first->second));
+            for (auto reason_id : GetReasonIds(kernel))
+            {
+                reason_ids.push_back(static_cast<uint32_t>(reason_id));
+            }
+            reason_offsets.push_back(static_cast<uint32_t>(reason_ids.size()));
+            for (auto participant : kernel->GetAllParticipants())
+            {
+                participant_ids.push_back(static_cast<uint32_t>(participant->id_));
+            }
+            participant_offsets.push_back(static_cast<uint32_t>(participant_ids.size()));
+        }
+        SpillBlockHeader header = {ids.size(), reason_ids.size(), participant_ids.size(), strings.size()};
+        spill_block_offsets_.push_back(static_cast<uint64_t>(spill_writer_.tellp()));
+        auto write = [this](const void *data, size_t size)
+        { spill_writer_.write(reinterpret_cast<const char *>(data), size); };
+        write(&header, sizeof(SpillBlockHeader));
+        write(ids.data(), ids.size() * sizeof(uint64_t));
+        write(records.data(), records.size() * sizeof(MappedChronicle::KernelRecord));
+        write(reason_offsets.data(), reason_offsets.size() * sizeof(uint32_t));
+        write(reason_ids.data(), reason_ids.size() * sizeof(uint32_t));
+        write(participant_offsets.data(), participant_offsets.size() * sizeof(uint32_t));
+        write(participant_ids.data(), participant_ids.size() * sizeof(uint32_t));
+        write(strings.data(), strings.size());
+        // blocks get read back while the simulation is still running
+        spill_writer_.flush();
+    }
+
+    Chronicle::SpillBlock Chronicle::ReadSpillBlock(size_t block_index) const
+    {
+        if (!spill_reader_.is_open())
+        {
+            spill_reader_.open(spill_path_, std::ios::binary);
+        }
+        spill_reader_.clear();
+        spill_reader_.seekg(spill_block_offsets_[block_index]);
+        auto read = [this](void *data, size_t size)
+        { spill_reader_.read(reinterpret_cast<char *>(data), size); };
+        SpillBlockHeader header;
+        read(&header, sizeof(SpillBlockHeader));
+        std::vector<uint64_t> ids(header.kernel_count);
+        std::vector<MappedChronicle::KernelRecord> records(header.kernel_count);
+        std::vector<uint32_t> reason_offsets(header.kernel_count + 1);
+        std::vector<uint32_t> reason_ids(header.reason_count);
+        std::vector<uint32_t> participant_offsets(header.kernel_count + 1);
+        std::vector<uint32_t> participant_ids(header.participant_count);
+        std::vector<char> strings(header.strings_size);
+        read(ids.data(), ids.size() * sizeof(uint64_t));
+        read(records.data(), records.size() * sizeof(MappedChronicle::KernelRecord));
+        read(reason_offsets.data(), reason_offsets.size() * sizeof(uint32_t));
+        read(reason_ids.data(), reason_ids.size() * sizeof(uint32_t));
+        read(participant_offsets.data(), participant_offsets.size() * sizeof(uint32_t));
+        read(participant_ids.data(), participant_ids.size() * sizeof(uint32_t));
+        read(strings.data(), strings.size());
+
+        SpillBlock block;
+        block.index = block_index;
+        block.kernels.resize(header.kernel_count);
+        for (size_t i = 0; i < block.kernels.size(); ++i)
+        {
+            SpilledKernel &spilled_kernel = block.kernels[i];
+            spilled_kernel.id = ids[i];
+            spilled_kernel.record = records[i];
+            spilled_kernel.name = &strings[records[i].name];
+            spilled_kernel.reason_ids.assign(reason_ids.begin() + reason_offsets[i], reason_ids.begin() + reason_offsets[i + 1]);
+            spilled_kernel.participant_ids.assign(participant_ids.begin() + participant_offsets[i], participant_ids.begin() + participant_offsets[i + 1]);
+        }
+        return block;
+    }
 } // namespace tattletale
\ No newline at end of file
@@ -4,12 +4,21 @@
 #include <memory>
 #include <list>
 #include <vector>
+#include <array>
 #include <string>
+#include <fstream>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <robin_hood.h>
 #include "shared/kernels/interactions/interaction.hpp"
 #include "shared/kernels/resourcekernels/emotion.hpp"
 #include "shared/kernels/resourcekernels/relationship.hpp"
 #include "shared/kernels/goal.hpp"
 #include "shared/random.hpp"
+#include "shared/mappedchronicle.hpp"
+#include "tale/actorstatestore.hpp"
+#include "tale/relationshipstore.hpp"
 
 namespace tattletale
 {
@@ -18,10 +27,70 @@ namespace tattletale
         Resource* wealth;
         std::vector<Emotion*> emotions;
     };
+    /**
+     * @brief Filter for Chronicle::FindKernels. Every field that is left at its default does not restrict the result.
+     */
+    struct KernelQuery
+    {
+        /**
+         * @brief Marks the actor and prototype filters as unused.
+         */
+        static constexpr size_t any_ = SIZE_MAX;
+        /**
+         * @brief Only \link Kernel Kernels \endlink of this KernelType, KernelType::kLast for every type.
+         */
+        KernelType type = KernelType::kLast;
+        /**
+         * @brief Only \link Kernel Kernels \endlink involving the Actor with this id.
+         */
+        size_t actor_id = any_;
+        /**
+         * @brief Only \link Interaction Interactions \endlink of the InteractionPrototype with this id.
+         */
+        size_t prototype_id = any_;
+        /**
+         * @brief Only \link Kernel Kernels \endlink created during or after this tick.
+         */
+        size_t first_tick = 0;
+        /**
+         * @brief Only \link Kernel Kernels \endlink created during or before this tick.
+         */
+        size_t last_tick = SIZE_MAX;
+    };
+    /**
+     * @brief A Kernel that was spilled to disk by Chronicle::SpillOldKernels, as read back from the spill file.
+     */
+    struct SpilledKernel
+    {
+        /**
+         * @brief The id the Kernel had in the Chronicle.
+         */
+        size_t id;
+        /**
+         * @brief Everything describing the Kernel, the name field is not used.
+         */
+        MappedChronicle::KernelRecord record;
+        /**
+         * @brief The name of the Kernel.
+         */
+        std::string name;
+        /**
+         * @brief The ids of all reasons of the Kernel, including the ones that were spilled.
+         */
+        std::vector<size_t> reason_ids;
+        /**
+         * @brief The ids of every Actor taking part in the Kernel, starting with its owner.
+         */
+        std::vector<size_t> participant_ids;
+    };
     class School;
     class Chronicle
     {
     public:
+        /**
+         * @brief How many \link Kernel Kernels \endlink of each KernelType were created, indexed by the converted KernelType.
+         */
+        using KernelTypeCounts = std::array<size_t, static_cast<size_t>(KernelType::kLast)>;
         /**
          * @brief Holds all instanced \link Actor Actors \endlink.
          */
@@ -29,13 +98,18 @@ namespace tattletale
 
         Chronicle(Random &random);
         ~Chronicle();
-        void Reset();
+        /**
+         * @brief Deletes every Actor and Kernel and prepares the Chronicle for a new simulation.
+         *
+         * @param actor_count How many \link Actor Actors \endlink the next simulation starts with, decides the layout of the RelationshipStore.
+         */
+        void Reset(size_t actor_count = 0);
         Actor *CreateActor(School &school, std::string first_name, std::string last_name);
 
         Interaction *CreateInteraction(
-            const std::shared_ptr<InteractionPrototype> prototype,
-            const std::shared_ptr<InteractionRequirement> requirement,
-            const std::shared_ptr<InteractionTendency> tendency,
+            const std::shared_ptr<InteractionPrototype> &prototype,
+            const std::shared_ptr<InteractionRequirement> &requirement,
+            const std::shared_ptr<InteractionTendency> &tendency,
             float chance,
             size_t tick,
             std::vector<Kernel *> reasons,
@@ -50,34 +124,455 @@ namespace tattletale
         float GetAverageInteractionReasonCount() const;
         std::string GetKnownActorsDescription(size_t actor_id) const;
         size_t GetKernelAmount() const;
+        /**
+         * @brief Getter for the amount of \link Kernel Kernels \endlink of one KernelType.
+         *
+         * @param type The KernelType.
+         * @return The amount of \link Kernel Kernels \endlink.
+         */
+        size_t GetKernelAmount(KernelType type) const;
+        /**
+         * @brief Getter for the sample variance of the chance of every Interaction so far.
+         *
+         * @return The variance, 0 if there are less than two \link Interaction Interactions \endlink.
+         */
+        float GetInteractionChanceVariance() const;
+        /**
+         * @brief Getter for how many \link Kernel Kernels \endlink have each amount of reasons.
+         *
+         * @return The histogram, indexed by the amount of reasons.
+         */
+        const std::vector<size_t> &GetReasonCountHistogram() const;
+        /**
+         * @brief Getter for how many \link Kernel Kernels \endlink currently have each amount of consequences.
+         *
+         * @return The histogram, indexed by the amount of consequences.
+         */
+        const std::vector<size_t> &GetConsequenceCountHistogram() const;
+        /**
+         * @brief Getter for how many \link Kernel Kernels \endlink of each KernelType were created during each tick.
+         *
+         * @return The counts, indexed by tick.
+         */
+        const std::vector<KernelTypeCounts> &GetKernelCountsPerTick() const;
+        /**
+         * @brief Exports GetKernelCountsPerTick as comma separated values with a header line and one line per tick.
+         *
+         * @return The exported time series.
+         */
+        std::string GetKernelCountsPerTickDescription() const;
         std::string GetRandomCausalityChainDescription(size_t depth) const;
         std::string GetKissingCausalityChainDescription(size_t depth) const;
         std::string GetGoalCausalityChainDescription(size_t depth) const;
         std::string GetActorInteractionsDescription(size_t id) const;
         Interaction *FindUnlikeliestInteraction(size_t tick_cutoff) const;
+        /**
+         * @brief Finds every Kernel matching all filters of the query, ordered by id.
+         *
+         * The tick range is resolved through the id of the first Kernel of each tick since \link Kernel Kernels \endlink are created in chronological order.
+         * The other filters each have a posting list of kernel ids sorted ascending, these get intersected starting with the shortest one.
+         * \link Kernel Kernels \endlink that were spilled to disk are left out.
+         *
+         * @param query The filters the \link Kernel Kernels \endlink have to match.
+         * @return The matching \link Kernel Kernels \endlink.
+         */
+        std::vector<Kernel *> FindKernels(const KernelQuery &query) const;
         Interaction *FindMostOccuringInteractionPrototypeForActorBeforeTick(size_t actor_id, size_t tick) const;
         ActorStatus FindActorStatusDuringTick(size_t actor_id, size_t tick) const;
         size_t RecursivelyFindHighestAbsoluteInterestChain(Kernel *kernel, size_t current_depth, size_t max_depth, std::vector<Kernel *> &out_chain) const;
         Emotion *GetLastEmotionOfType(size_t tick, size_t actor_id, EmotionType type) const;
         Resource *GetLastWealth(size_t tick, size_t actor_id) const;
+        /**
+         * @brief Getter for every Relationship of one RelationshipType an Actor had towards another Actor, sorted by tick.
+         *
+         * @param owner_id The id of the Actor owning the \link Relationship Relationships \endlink.
+         * @param target_id The id of the Actor the \link Relationship Relationships \endlink are directed at.
+         * @param type The RelationshipType.
+         * @return The timeline, empty if the \link Actor Actors \endlink never had a Relationship of this type.
+         */
+        const std::vector<Relationship *> &GetRelationshipTimeline(size_t owner_id, size_t target_id, RelationshipType type) const;
+        /**
+         * @brief Finds the last Relationship of one RelationshipType an Actor had towards another Actor before the passed tick.
+         *
+         * @param tick The tick before which the Relationship must have been created.
+         * @param owner_id The id of the Actor owning the Relationship.
+         * @param target_id The id of the Actor the Relationship is directed at.
+         * @param type The RelationshipType.
+         * @return The last Relationship before the tick, nullptr if there is none.
+         */
+        Relationship *GetLastRelationshipOfType(size_t tick, size_t owner_id, size_t target_id, RelationshipType type) const;
         size_t GetLastTick() const;
         Random &GetRandom() const;
+        /**
+         * @brief Getter for the current numeric state of all \link Actor Actors \endlink.
+         *
+         * The store lives in the Chronicle, so the \link Actor Actors \endlink can still be queried after the School that simulated them is gone.
+         *
+         * @return Reference to the ActorStateStore object.
+         */
+        ActorStateStore &GetActorStateStore();
+        /**
+         * @brief Getter for the current values of all \link Relationship Relationships \endlink between \link Actor Actors \endlink.
+         *
+         * The store lives in the Chronicle, so the \link Actor Actors \endlink can still be queried after the School that simulated them is gone.
+         *
+         * @return Reference to the RelationshipStore object.
+         */
+        RelationshipStore &GetRelationshipStore();
+        /**
+         * @brief Turns on spilling, so SpillOldKernels moves \link Kernel Kernels \endlink older than the tick horizon into a file.
+         *
+         * Spilled \link Kernel Kernels \endlink are deleted, only their ids stay resident in the posting lists of FindKernels.
+         * Every query that walks the resident \link Kernel Kernels \endlink, like the causality descriptions or GetEveryPossibleChain, only sees
+         * what happened within the horizon, while the running statistics still cover the whole simulation. The state of the \link Actor Actors \endlink at the start
+         * of the horizon stays resident, so GetLastEmotionOfType, GetLastWealth, GetLastRelationshipOfType and FindActorStatusDuringTick are exact from GetSpillHorizonTick on
+         * and may return nullptr for earlier ticks. FindMostOccuringInteractionPrototypeForActorBeforeTick still counts spilled \link Interaction Interactions \endlink
+         * but returns nullptr for ticks before GetSpillHorizonTick. Reasons and consequences pointing at spilled \link Kernel Kernels \endlink are removed from the resident
+         * ones, GetReasonIds and GetSpilledKernel resolve them from the file instead.
+         *
+         * @param path Path of the spill file, an existing file gets overwritten.
+         * @param tick_horizon How many ticks before the current tick \link Kernel Kernels \endlink stay resident.
+         * @return Wether the file could be opened.
+         */
+        bool EnableSpilling(const std::string &path, size_t tick_horizon);
+        /**
+         * @brief Appends every Kernel that was created more than the tick horizon before the current tick to the spill file as one block.
+         *
+         * The current Emotion, wealth, Relationship and Goal of every Actor are still used as reasons for new \link Kernel Kernels \endlink,
+         * so they stay resident until they get replaced. The other \link Kernel Kernels \endlink IsPinned lists are kept as well. Does nothing if spilling is not enabled.
+         *
+         * @param current_tick The current tick of the simulation.
+         */
+        void SpillOldKernels(size_t current_tick);
+        /**
+         * @brief Getter for how many \link Kernel Kernels \endlink were spilled to disk.
+         *
+         * @return The amount of spilled \link Kernel Kernels \endlink.
+         */
+        size_t GetSpilledKernelAmount() const;
+        /**
+         * @brief Getter for the first tick whose \link Kernel Kernels \endlink were all kept resident by the last call of SpillOldKernels.
+         *
+         * @return The tick, 0 if nothing was spilled yet.
+         */
+        size_t GetSpillHorizonTick() const;
+        /**
+         * @brief Checks wether a Kernel was spilled to disk.
+         *
+         * @param kernel_id The id of the Kernel.
+         * @return The result of the check.
+         */
+        bool IsSpilled(size_t kernel_id) const;
+        /**
+         * @brief Reads a spilled Kernel back from the spill file.
+         *
+         * The last few blocks that were read are kept in memory, so following reasons of spilled \link Kernel Kernels \endlink usually does not touch the disk.
+         *
+         * @param kernel_id The id of the Kernel, it has to be spilled.
+         * @return The spilled Kernel.
+         */
+        SpilledKernel GetSpilledKernel(size_t kernel_id) const;
+        /**
+         * @brief Calls a function for every Kernel in ascending order of ids, reading the spilled ones back from the spill file.
+         *
+         * Each block of the spill file is decoded exactly once, when its first Kernel is reached, and dropped after its last one was visited.
+         * Resident \link Kernel Kernels \endlink are described the same way, their reasons include the ones that were spilled.
+         * The name field of the record is not used. The described Kernel is only valid during the call.
+         *
+         * @param function Gets called with the description of each Kernel.
+         */
+        void ForEachKernel(const std::function<void(const SpilledKernel &)> &function) const;
+        /**
+         * @brief Getter for the ids of all reasons of a resident Kernel, including the ones that were spilled.
+         *
+         * @param kernel The Kernel.
+         * @return The kernel ids of the reasons.
+         */
+        std::vector<size_t> GetReasonIds(const Kernel *kernel) const;
 
     private:
         Random &random_;
+        /**
+         * @brief Holds the current numeric state of all \link Actor Actors \endlink in dense arrays.
+         */
+        ActorStateStore actor_state_store_;
+        /**
+         * @brief Holds the current values of all \link Relationship Relationships \endlink between \link Actor Actors \endlink.
+         */
+        RelationshipStore relationship_store_;
         std::vector<Kernel *>
             all_kernels_;
         std::vector<Interaction *>
             all_interactions_;
         std::vector<std::vector<Interaction *>>
             interactions_by_actor_;
-        std::vector<std::vector<Kernel *>>
-            kernels_by_actor_;
-        std::vector<std::vector<Emotion *>>
+        /**
+         * @brief Posting list of kernel ids for each Actor, sorted ascending.
+         */
+        std::vector<std::vector<size_t>>
+            kernel_ids_by_actor_;
+        /**
+         * @brief Posting list of kernel ids for each KernelType, sorted ascending.
+         */
+        std::array<std::vector<size_t>, static_cast<size_t>(KernelType::kLast)>
+            kernel_ids_by_type_;
+        /**
+         * @brief Posting list of interaction kernel ids for each prototype id, sorted ascending.
+         */
+        std::vector<std::vector<size_t>>
+            kernel_ids_by_prototype_;
+        /**
+         * @brief Ids of every Kernel that has at least one Goal as reason, sorted ascending.
+         */
+        std::vector<size_t>
+            kernel_ids_with_goal_reason_;
+        /**
+         * @brief Every Interaction ordered ascending by chance and then by id. Only built when it gets queried after new \link Interaction Interactions \endlink were created.
+         */
+        mutable std::vector<Interaction *>
+            interactions_by_chance_;
+        /**
+         * @brief Wether interactions_by_chance_ is missing \link Interaction Interactions \endlink.
+         */
+        mutable bool interactions_by_chance_outdated_ = false;
+        /**
+         * @brief Scratch buffer for the prototype counts of FindMostOccuringInteractionPrototypeForActorBeforeTick.
+         */
+        mutable std::vector<size_t> prototype_occurence_scratch_;
+        /**
+         * @brief Timeline of every Emotion of each Actor, split by EmotionType and sorted by tick.
+         */
+        std::vector<std::array<std::vector<Emotion *>, static_cast<size_t>(EmotionType::kLast)>>
             emotions_by_actor_;
+        /**
+         * @brief Timeline of every wealth Resource of each Actor, sorted by tick.
+         */
         std::vector<std::vector<Resource *>>
             wealth_by_actor_;
+        /**
+         * @brief Sum of the chance of every Interaction, summed up in creation order.
+         */
+        float interaction_chance_sum_ = 0;
+        /**
+         * @brief Running mean of the chance of every Interaction for the variance calculation.
+         */
+        double interaction_chance_mean_ = 0;
+        /**
+         * @brief Running sum of squared differences from interaction_chance_mean_.
+         */
+        double interaction_chance_m2_ = 0;
+        /**
+         * @brief Sum of the amount of reasons of every Interaction.
+         */
+        float interaction_reason_count_sum_ = 0;
+        /**
+         * @brief Backing storage of GetReasonCountHistogram.
+         */
+        std::vector<size_t> reason_count_histogram_;
+        /**
+         * @brief Backing storage of GetConsequenceCountHistogram.
+         */
+        std::vector<size_t> consequence_count_histogram_;
+        /**
+         * @brief Backing storage of GetKernelCountsPerTick.
+         */
+        std::vector<KernelTypeCounts> kernel_counts_by_tick_;
+        /**
+         * @brief Timelines of every Relationship between each pair of \link Actor Actors \endlink, split by RelationshipType and sorted by tick.
+         *
+         * Keyed by the owner id in the upper and the target id in the lower 32 bits, see GetActorPairKey.
+         */
+        robin_hood::unordered_flat_map<uint64_t, std::array<std::vector<Relationship *>, static_cast<size_t>(RelationshipType::kLast)>>
+            relationships_by_actor_pair_;
+        /**
+         * @brief After how many \link Interaction Interactions \endlink of an Actor a checkpoint of its prototype counts is stored.
+         */
+        static constexpr size_t prototype_count_checkpoint_interval_ = 64;
+        /**
+         * @brief For each Actor how often it took part in an Interaction of each InteractionPrototype so far, indexed by prototype id.
+         */
+        std::vector<std::vector<uint32_t>>
+            prototype_counts_by_actor_;
+        /**
+         * @brief For each Actor the prototype counts after every prototype_count_checkpoint_interval_ \link Interaction Interactions \endlink.
+         *
+         * Checkpoint i holds the counts of the first i * prototype_count_checkpoint_interval_ \link Interaction Interactions \endlink, so the first checkpoint is always empty.
+         * Prototype ids that did not occur yet when a checkpoint was stored are left out of it.
+         */
+        std::vector<std::vector<std::vector<uint32_t>>>
+            prototype_count_checkpoints_by_actor_;
+        /**
+         * @brief For each Actor the first Interaction of each InteractionPrototype it took part in, indexed by prototype id.
+         */
+        std::vector<std::vector<Interaction *>>
+            first_interaction_by_prototype_by_actor_;
         size_t highest_interaction_id = 0;
+        /**
+         * @brief For each tick the id of the first Kernel created during or after it.
+         */
+        std::vector<size_t>
+            first_kernel_id_by_tick_;
+        /**
+         * @brief Start of every block in the spill file.
+         *
+         * It is followed by the kernel count uint64_t ids, the MappedChronicle::KernelRecord of each Kernel, the reasons as kernel count + 1 uint32_t offsets
+         * followed by the uint32_t reason ids, the participants in the same layout and the string table holding the names, each one terminated by '\0'.
+         */
+        struct SpillBlockHeader
+        {
+            /**
+             * @brief Amount of \link Kernel Kernels \endlink in the block.
+             */
+            uint64_t kernel_count;
+            /**
+             * @brief Amount of reason ids in the block.
+             */
+            uint64_t reason_count;
+            /**
+             * @brief Amount of participant ids in the block.
+             */
+            uint64_t participant_count;
+            /**
+             * @brief Size of the string table of the block in bytes.
+             */
+            uint64_t strings_size;
+        };
+        /**
+         * @brief A decoded block of the spill file.
+         */
+        struct SpillBlock
+        {
+            /**
+             * @brief The index of the block.
+             */
+            size_t index;
+            /**
+             * @brief The \link Kernel Kernels \endlink of the block, sorted by id.
+             */
+            std::vector<SpilledKernel> kernels;
+        };
+        /**
+         * @brief How many decoded blocks are kept in spill_cache_.
+         */
+        static constexpr size_t spill_cache_capacity_ = 4;
+        /**
+         * @brief How many ticks before the current tick \link Kernel Kernels \endlink stay resident, 0 if spilling is disabled.
+         */
+        size_t spill_tick_horizon_ = 0;
+        /**
+         * @brief Appends the blocks to the spill file.
+         */
+        std::ofstream spill_writer_;
+        /**
+         * @brief Reads blocks back from the spill file.
+         */
+        mutable std::ifstream spill_reader_;
+        /**
+         * @brief Path of the spill file.
+         */
+        std::string spill_path_;
+        /**
+         * @brief Offset of each block in the spill file.
+         */
+        std::vector<uint64_t> spill_block_offsets_;
+        /**
+         * @brief For each kernel id the index of the block it was spilled into, MappedChronicle::no_id_ if it is resident.
+         */
+        std::vector<uint32_t> spill_block_by_kernel_;
+        /**
+         * @brief Id of the first Kernel that was not looked at by SpillOldKernels yet.
+         */
+        size_t spill_frontier_ = 0;
+        /**
+         * @brief Ids of the \link Kernel Kernels \endlink behind the horizon that were kept resident since they are still in use, sorted ascending.
+         */
+        std::vector<size_t> pinned_kernel_ids_;
+        /**
+         * @brief Amount of spilled \link Kernel Kernels \endlink.
+         */
+        size_t spilled_kernel_count_ = 0;
+        /**
+         * @brief The full reason ids of every resident Kernel that lost a reason to spilling.
+         */
+        robin_hood::unordered_map<size_t, std::vector<size_t>> original_reason_ids_;
+        /**
+         * @brief How many consequences every resident Kernel lost to spilling, so the consequence histogram keeps counting them.
+         */
+        robin_hood::unordered_map<size_t, size_t> spilled_consequence_counts_;
+        /**
+         * @brief The tick horizon of the last call of SpillOldKernels, every Kernel created before it was either spilled or pinned. 0 if nothing was spilled yet.
+         */
+        size_t spill_horizon_tick_ = 0;
+        /**
+         * @brief For each Actor how many of its \link Interaction Interactions \endlink were created before spill_horizon_tick_, which is the position of the first one left in interactions_by_actor_.
+         */
+        std::vector<size_t> interaction_count_behind_horizon_by_actor_;
+        /**
+         * @brief For each Actor the prototype counts of its \link Interaction Interactions \endlink that were created before spill_horizon_tick_.
+         */
+        std::vector<std::vector<uint32_t>> prototype_counts_behind_horizon_by_actor_;
+        /**
+         * @brief The most recently read blocks, the most recent one first.
+         */
+        mutable std::list<SpillBlock> spill_cache_;
+        /**
+         * @brief Finds the last entry of a timeline that was created before the passed tick with a binary search.
+         *
+         * Relies on the timeline being sorted by tick, which holds as long as \link Kernel Kernels \endlink are created in chronological order.
+         *
+         * @param timeline The timeline to search in.
+         * @param tick The tick before which the entry must have been created.
+         * @return The last entry before the tick, nullptr if there is none.
+         */
+        template <typename T>
+        static T *FindLastBeforeTick(const std::vector<T *> &timeline, size_t tick)
+        {
+            auto next = std::lower_bound(timeline.begin(), timeline.end(), tick, [](const T *entry, size_t value)
+                                         { return entry->tick_ < value; });
+            return (next == timeline.begin() ? nullptr : *(next - 1));
+        }
+        /**
+         * @brief Adds a newly created Kernel to all_kernels_, registers it as consequence of its reasons and updates the indexes and statistics that do not depend on its concrete type.
+         *
+         * @param kernel The new Kernel.
+         */
+        void AddKernel(Kernel *kernel);
+        /**
+         * @brief Checks wether a Kernel behind the horizon still has to stay resident.
+         *
+         * This is the case for the latest Emotion, wealth and Relationship of each kind, since these are the current state of the \link Actor Actors \endlink,
+         * and for the last one of each kind before the horizon, since it is the state at the start of the resident ticks. The current Goal of each Actor
+         * and the first Interaction of each InteractionPrototype an Actor took part in stay resident as well.
+         *
+         * @param kernel The Kernel.
+         * @param horizon_tick The first tick whose \link Kernel Kernels \endlink stay resident.
+         * @return The result of the check.
+         */
+        bool IsPinned(Kernel *kernel, size_t horizon_tick) const;
+        /**
+         * @brief Appends one block to the spill file.
+         *
+         * @param kernels The \link Kernel Kernels \endlink of the block, sorted by id and still linked to their reasons.
+         */
+        void WriteSpillBlock(const std::vector<Kernel *> &kernels);
+        /**
+         * @brief Reads one block back from the spill file.
+         *
+         * @param block_index The index of the block.
+         * @return The decoded block.
+         */
+        SpillBlock ReadSpillBlock(size_t block_index) const;
+        /**
+         * @brief Packs the ids of two \link Actor Actors \endlink into the key of relationships_by_actor_pair_.
+         *
+         * @param owner_id The id of the Actor owning the Relationship.
+         * @param target_id The id of the Actor the Relationship is directed at.
+         * @return The key.
+         */
+        static uint64_t GetActorPairKey(size_t owner_id, size_t target_id)
+        {
+            return (static_cast<uint64_t>(owner_id) << 32) | static_cast<uint32_t>(target_id);
+        }
         std::vector<std::vector<Kernel *>> GetEveryPossibleChainRecursivly(Kernel *kernel, size_t current_depth, size_t max_depth) const;
         std::string GetRecursiveKernelDescription(Kernel *kernel, size_t current_depth, size_t max_depth) const;
     };
@@ -0,0 +1,467 @@
+#include "shared/chroniclearchive.hpp"
+#include "shared/chronicle.hpp"
+#include "shared/actor.hpp"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <robin_hood.h>
+
+namespace tattletale
+{
+    namespace
+    {
+        /**
+         * @brief Buffers the encoded bytes so the file is written in large chunks.
+         */
+        class ArchiveWriter
+        {
+        public:
+            /**
+             * @brief Constructor opening the file.
+             *
+             * @param path Path of the file, an existing file gets overwritten.
+             */
+            ArchiveWriter(const std::string &path) : file_(path, std::ios::binary | std::ios::trunc)
+            {
+                buffer_.reserve(buffer_size_);
+            }
+            /**
+             * @brief Writes the remaining bytes and checks wether everything was written.
+             *
+             * @return The result of the check.
+             */
+            bool Finish()
+            {
+                Flush();
+                file_.flush();
+                return static_cast<bool>(file_);
+            }
+            /**
+             * @brief Checks wether the file could be opened.
+             *
+             * @return The result of the check.
+             */
+            bool IsOpen() const
+            {
+                return static_cast<bool>(file_);
+            }
+            /**
+             * @brief Appends one byte.
+             *
+             * @param byte The byte.
+             */
+            void WriteByte(unsigned char byte)
+            {
+                buffer_.push_back(byte);
+                if (buffer_.size() >= buffer_size_)
+                {
+                    Flush();
+                }
+            }
+            /**
+             * @brief Appends raw bytes.
+             *
+             * @param data The bytes.
+             * @param size The amount of bytes.
+             */
+            void WriteBytes(const void *data, size_t size)
+            {
+                const unsigned char *bytes = static_cast<const unsigned char *>(data);
+                buffer_.insert(buffer_.end(), bytes, bytes + size);
+                if (buffer_.size() >= buffer_size_)
+                {
+                    Flush();
+                }
+            }
+            /**
+             * @brief Appends an unsigned LEB128 varint, 7 bits per byte with the highest bit marking that another byte follows.
+             *
+             * @param value The value.
+             */
+            void WriteVarint(uint64_t value)
+            {
+                while (value >= 0x80)
+                {
+                    WriteByte(static_cast<unsigned char>(value | 0x80));
+                    value >>= 7;
+                }
+                WriteByte(static_cast<unsigned char>(value));
+            }
+            /**
+             * @brief Appends the length of a string as varint followed by its bytes.
+             *
+             * @param value The string.
+             */
+            void WriteString(const std::string &value)
+            {
+                WriteVarint(value.size());
+                WriteBytes(value.data(), value.size());
+            }
+
+        private:
+            /**
+             * @brief How many bytes are collected before they are written.
+             */
+            static constexpr size_t buffer_size_ = 1 << 16;
+            /**
+             * @brief The opened file.
+             */
+            std::ofstream file_;
+            /**
+             * @brief The bytes that were not written yet.
+             */
+            std::vector<unsigned char> buffer_;
+            /**
+             * @brief Writes the buffered bytes to the file.
+             */
+            void Flush()
+            {
+                file_.write(reinterpret_cast<const char *>(buffer_.data()), buffer_.size());
+                buffer_.clear();
+            }
+        };
+        /**
+         * @brief Maps signed values to unsigned ones, so small negative values also get short varints.
+         *
+         * @param value The signed value.
+         * @return The unsigned value.
+         */
+        uint64_t ZigZagEncode(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+        /**
+         * @brief Reverses ZigZagEncode.
+         *
+         * @param value The unsigned value.
+         * @return The signed value.
+         */
+        int64_t ZigZagDecode(uint64_t value)
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+        /**
+         * @brief Checks wether \link Kernel Kernels \endlink of a KernelType store a subtype.
+         *
+         * @param type The KernelType.
+         * @return The result of the check.
+         */
+        bool HasSubtype(KernelType type)
+        {
+            return type == KernelType::kEmotion || type == KernelType::kRelationship || type == KernelType::kGoal || type == KernelType::kInteraction;
+        }
+        /**
+         * @brief Checks wether \link Kernel Kernels \endlink of a KernelType store a value.
+         *
+         * @param type The KernelType.
+         * @return The result of the check.
+         */
+        bool HasValue(KernelType type)
+        {
+            return type == KernelType::kResource || type == KernelType::kEmotion || type == KernelType::kRelationship;
+        }
+        /**
+         * @brief Reasons stored directly in the upper 5 bits of the first byte of a Kernel, this value means the rest of the amount follows as varint.
+         */
+        constexpr size_t reason_count_escape = 31;
+    } // namespace
+
+    bool ChronicleArchive::Write(const Chronicle &chronicle, const std::string &path)
+    {
+        ArchiveWriter writer(path);
+        if (!writer.IsOpen())
+        {
+            return false;
+        }
+        writer.WriteBytes(magic_, sizeof(magic_));
+        writer.WriteBytes(&version_, sizeof(version_));
+        uint64_t kernel_count = chronicle.GetKernelAmount();
+        writer.WriteBytes(&kernel_count, sizeof(kernel_count));
+        writer.WriteVarint(chronicle.actors_.size());
+        for (auto actor : chronicle.actors_)
+        {
+            writer.WriteString(actor->first_name_);
+            writer.WriteString(actor->last_name_);
+        }
+
+        // spilled kernels are read back from the spill file one block at a time, so the archive also covers what happened before the spill horizon
+        robin_hood::unordered_map<std::string, uint32_t> name_indices;
+        size_t previous_tick = 0;
+        auto write_kernel = [&](const SpilledKernel &kernel)
+        {
+            const MappedChronicle::KernelRecord &record = kernel.record;
+            const auto &reasons = kernel.reason_ids;
+            KernelType type = static_cast<KernelType>(record.type);
+            size_t inline_reason_count = std::min(reasons.size(), reason_count_escape);
+            writer.WriteByte(static_cast<unsigned char>(static_cast<size_t>(type) | (inline_reason_count << 3)));
+            if (inline_reason_count == reason_count_escape)
+            {
+                writer.WriteVarint(reasons.size() - reason_count_escape);
+            }
+            writer.WriteVarint(record.tick - previous_tick);
+            previous_tick = record.tick;
+            writer.WriteVarint(record.owner_id);
+            auto name_index = name_indices.emplace(kernel.name, static_cast<uint32_t>(name_indices.size()));
+            writer.WriteVarint(name_index.first->second);
+            if (name_index.second)
+            {
+                writer.WriteString(kernel.name);
+            }
+
+            if (HasSubtype(type))
+            {
+                writer.WriteVarint(record.subtype);
+            }
+            if (type == KernelType::kRelationship)
+            {
+                writer.WriteVarint(record.target_id);
+            }
+            if (HasValue(type))
+            {
+                float value = std::clamp(record.value, -1.0f, 1.0f);
+                writer.WriteVarint(ZigZagEncode(std::lround(value * value_scale_)));
+            }
+            if (type == KernelType::kInteraction)
+            {
+                writer.WriteBytes(&record.chance, sizeof(record.chance));
+                const auto &participant_ids = kernel.participant_ids;
+                writer.WriteVarint(participant_ids.size() - 1);
+                for (size_t i = 1; i < participant_ids.size(); ++i)
+                {
+                    writer.WriteVarint(participant_ids[i]);
+                }
+            }
+            for (auto reason_id : reasons)
+            {
+                writer.WriteVarint(kernel.id - reason_id);
+            }
+        };
+        chronicle.ForEachKernel(write_kernel);
+        return writer.Finish();
+    }
+
+    bool ChronicleArchive::Open(const std::string &path)
+    {
+        Close();
+        file_.open(path, std::ios::binary);
+        if (!file_)
+        {
+            Close();
+            return false;
+        }
+        char magic[sizeof(magic_)];
+        uint32_t version = 0;
+        uint64_t kernel_count = 0;
+        uint64_t actor_count = 0;
+        if (!ReadBytes(magic, sizeof(magic)) || std::memcmp(magic, magic_, sizeof(magic_)) != 0 || !ReadBytes(&version, sizeof(version)) || version != version_ || !ReadBytes(&kernel_count, sizeof(kernel_count)) || !ReadVarint(actor_count))
+        {
+            Close();
+            return false;
+        }
+        kernel_count_ = kernel_count;
+        for (uint64_t actor_id = 0; actor_id < actor_count; ++actor_id)
+        {
+            std::string first_name;
+            std::string last_name;
+            if (!ReadString(first_name) || !ReadString(last_name))
+            {
+                Close();
+                return false;
+            }
+            actor_names_.push_back(first_name + " " + last_name);
+        }
+        return true;
+    }
+
+    void ChronicleArchive::Close()
+    {
+        file_.close();
+        file_.clear();
+        buffer_.clear();
+        buffer_position_ = 0;
+        kernel_count_ = 0;
+        next_id_ = 0;
+        previous_tick_ = 0;
+        names_.clear();
+        actor_names_.clear();
+    }
+
+    size_t ChronicleArchive::GetKernelAmount() const
+    {
+        return kernel_count_;
+    }
+
+    const std::vector<std::string> &ChronicleArchive::GetActorNames() const
+    {
+        return actor_names_;
+    }
+
+    bool ChronicleArchive::Next(ArchivedKernel &out_kernel)
+    {
+        if (next_id_ >= kernel_count_)
+        {
+            return false;
+        }
+        unsigned char first_byte;
+        uint64_t reason_count;
+        uint64_t tick_delta;
+        uint64_t owner_id;
+        uint64_t name_index;
+        if (!ReadByte(first_byte))
+        {
+            return false;
+        }
+        reason_count = first_byte >> 3;
+        if (reason_count == reason_count_escape)
+        {
+            uint64_t extra_reason_count;
+            if (!ReadVarint(extra_reason_count))
+            {
+                return false;
+            }
+            reason_count += extra_reason_count;
+        }
+        if (!ReadVarint(tick_delta) || !ReadVarint(owner_id) || !ReadVarint(name_index))
+        {
+            return false;
+        }
+        if (name_index == names_.size())
+        {
+            names_.emplace_back();
+            if (!ReadString(names_.back()))
+            {
+                return false;
+            }
+        }
+        else if (name_index > names_.size())
+        {
+            return false;
+        }
+
+        KernelType type = static_cast<KernelType>(first_byte & 0x7);
+        MappedChronicle::KernelRecord &record = out_kernel.record;
+        record = {};
+        record.tick = previous_tick_ + tick_delta;
+        record.owner_id = static_cast<uint32_t>(owner_id);
+        record.target_id = MappedChronicle::no_id_;
+        record.chance = 1.0f;
+        record.type = static_cast<uint8_t>(type);
+        out_kernel.id = next_id_;
+        out_kernel.name = names_[name_index];
+        out_kernel.participant_ids.assign(1, record.owner_id);
+        uint64_t value;
+        if (HasSubtype(type))
+        {
+            if (!ReadVarint(value))
+            {
+                return false;
+            }
+            record.subtype = static_cast<uint32_t>(value);
+        }
+        if (type == KernelType::kRelationship)
+        {
+            if (!ReadVarint(value))
+            {
+                return false;
+            }
+            record.target_id = static_cast<uint32_t>(value);
+            out_kernel.participant_ids.push_back(record.target_id);
+        }
+        if (HasValue(type))
+        {
+            if (!ReadVarint(value))
+            {
+                return false;
+            }
+            record.value = static_cast<float>(ZigZagDecode(value)) / value_scale_;
+        }
+        if (type == KernelType::kInteraction)
+        {
+            uint64_t other_participant_count;
+            if (!ReadBytes(&record.chance, sizeof(record.chance)) || !ReadVarint(other_participant_count))
+            {
+                return false;
+            }
+            for (uint64_t i = 0; i < other_participant_count; ++i)
+            {
+                if (!ReadVarint(value))
+                {
+                    return false;
+                }
+                out_kernel.participant_ids.push_back(static_cast<uint32_t>(value));
+            }
+        }
+        out_kernel.reason_ids.clear();
+        for (uint64_t i = 0; i < reason_count; ++i)
+        {
+            if (!ReadVarint(value))
+            {
+                return false;
+            }
+            out_kernel.reason_ids.push_back(next_id_ - value);
+        }
+        previous_tick_ = record.tick;
+        ++next_id_;
+        return true;
+    }
+
+    bool ChronicleArchive::ReadByte(unsigned char &out_byte)
+    {
+        if (buffer_position_ >= buffer_.size())
+        {
+            buffer_.resize(buffer_size_);
+            file_.read(reinterpret_cast<char *>(buffer_.data()), buffer_size_);
+            buffer_.resize(static_cast<size_t>(file_.gcount()));
+            buffer_position_ = 0;
+            if (buffer_.empty())
+            {
+                return false;
+            }
+        }
+        out_byte = buffer_[buffer_position_++];
+        return true;
+    }
+
+    bool ChronicleArchive::ReadBytes(void *data, size_t size)
+    {
+        unsigned char *bytes = static_cast<unsigned char *>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (!ReadByte(bytes[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool ChronicleArchive::ReadVarint(uint64_t &out_value)
+    {
+        out_value = 0;
+        for (size_t shift = 0; shift < 64; shift += 7)
+        {
+            unsigned char byte;
+            if (!ReadByte(byte))
+            {
+                return false;
+            }
+            out_value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ChronicleArchive::ReadString(std::string &out_string)
+    {
+        uint64_t size;
+        if (!ReadVarint(size))
+        {
+            return false;
+        }
+        out_string.resize(size);
+        return ReadBytes(&out_string[0], size);
+    }
+} // namespace tattletale
@@ -0,0 +1,180 @@
+#ifndef TALE_GLOBALS_CHRONICLEARCHIVE_H
+#define TALE_GLOBALS_CHRONICLEARCHIVE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+#include "shared/mappedchronicle.hpp"
+
+namespace tattletale
+{
+    class Chronicle;
+    /**
+     * @brief A Kernel as read back from a ChronicleArchive.
+     */
+    struct ArchivedKernel
+    {
+        /**
+         * @brief The id the Kernel had in the Chronicle.
+         */
+        size_t id;
+        /**
+         * @brief Everything describing the Kernel, the name field is not used and the value is quantised.
+         */
+        MappedChronicle::KernelRecord record;
+        /**
+         * @brief The name of the Kernel.
+         */
+        std::string name;
+        /**
+         * @brief The ids of all reasons of the Kernel.
+         */
+        std::vector<size_t> reason_ids;
+        /**
+         * @brief The ids of every Actor taking part in the Kernel, starting with its owner.
+         */
+        std::vector<uint32_t> participant_ids;
+    };
+    /**
+     * @brief Compact file format for archiving the result of many simulations.
+     *
+     * The file is written and read strictly front to back, so neither side ever holds more than one Kernel and a small buffer in memory.
+     * After a fixed size header and the names of every Actor each Kernel is stored in id order, which makes its id implicit:
+     * - One byte holding the KernelType in the lowest 3 bits and the amount of reasons in the upper 5 bits, 31 meaning the rest of the amount follows as varint.
+     * - The tick as delta to the tick of the previous Kernel and the owner id.
+     * - The name as index into the names seen so far in the file. A new name gets the next index and is followed by its length and bytes.
+     * - The subtype, the target Actor, the value and the chance, but only where the KernelType has them. Values are quantised to 16 bit, chances are stored as is.
+     * - The other participants of \link Interaction Interactions \endlink.
+     * - The reasons as delta from the own id, which is small since reasons are almost always recent.
+     *
+     * All numbers except the header and the chances are unsigned LEB128 varints, signed ones are zigzag encoded before.
+     */
+    class ChronicleArchive
+    {
+    public:
+        /**
+         * @brief Identifies the file format, the first bytes of every file.
+         */
+        static constexpr char magic_[8] = {'T', 'T', 'A', 'R', 'C', 'H', 'V', '\0'};
+        /**
+         * @brief Version of the file format, only files of exactly this version can be opened.
+         */
+        static constexpr uint32_t version_ = 1;
+        /**
+         * @brief Values are stored as round(value * value_scale_) after being clamped to [-1, 1], the range the simulation keeps them in.
+         */
+        static constexpr float value_scale_ = 32767.0f;
+
+        /**
+         * @brief Writes a Chronicle to an archive file.
+         *
+         * Spilled \link Kernel Kernels \endlink are read back through Chronicle::ForEachKernel, so the archive is the same as the one of a Chronicle that never spilled.
+         *
+         * @param chronicle The Chronicle that will be written.
+         * @param path Path of the file, an existing file gets overwritten.
+         * @return Wether the file could be written.
+         */
+        static bool Write(const Chronicle &chronicle, const std::string &path);
+
+        /**
+         * @brief Opens an archive file for reading, closing the previously opened one.
+         *
+         * @param path Path of the file.
+         * @return Wether the file could be opened and is an archive of the current version.
+         */
+        bool Open(const std::string &path);
+        /**
+         * @brief Closes the current file, does nothing if no file is open.
+         */
+        void Close();
+        /**
+         * @brief Getter for the amount of \link Kernel Kernels \endlink in the file.
+         *
+         * @return The amount of \link Kernel Kernels \endlink.
+         */
+        size_t GetKernelAmount() const;
+        /**
+         * @brief Getter for the full names of every Actor in the file.
+         *
+         * @return The first and last names separated by a space, indexed by actor id.
+         */
+        const std::vector<std::string> &GetActorNames() const;
+        /**
+         * @brief Reads the next Kernel.
+         *
+         * @param out_kernel Receives the Kernel.
+         * @return Wether there was another Kernel and it could be read, if not out_kernel is left in an unspecified state.
+         */
+        bool Next(ArchivedKernel &out_kernel);
+
+    private:
+        /**
+         * @brief How many bytes are read from the file at once.
+         */
+        static constexpr size_t buffer_size_ = 1 << 16;
+        /**
+         * @brief The opened file.
+         */
+        std::ifstream file_;
+        /**
+         * @brief The bytes read from the file that were not decoded yet start at buffer_position_.
+         */
+        std::vector<unsigned char> buffer_;
+        /**
+         * @brief Position of the next byte to decode in buffer_.
+         */
+        size_t buffer_position_ = 0;
+        /**
+         * @brief Amount of \link Kernel Kernels \endlink in the file.
+         */
+        size_t kernel_count_ = 0;
+        /**
+         * @brief The id of the Kernel that Next reads.
+         */
+        size_t next_id_ = 0;
+        /**
+         * @brief The tick of the Kernel that was read last.
+         */
+        size_t previous_tick_ = 0;
+        /**
+         * @brief Every name read so far, indexed in the order they appeared in the file.
+         */
+        std::vector<std::string> names_;
+        /**
+         * @brief Backing storage of GetActorNames.
+         */
+        std::vector<std::string> actor_names_;
+        /**
+         * @brief Reads one byte, refilling the buffer if necessary.
+         *
+         * @param out_byte Receives the byte.
+         * @return Wether a byte could be read.
+         */
+        bool ReadByte(unsigned char &out_byte);
+        /**
+         * @brief Reads raw bytes.
+         *
+         * @param data Receives the bytes.
+         * @param size The amount of bytes.
+         * @return Wether every byte could be read.
+         */
+        bool ReadBytes(void *data, size_t size);
+        /**
+         * @brief Reads an unsigned varint.
+         *
+         * @param out_value Receives the value.
+         * @return Wether the value could be read.
+         */
+        bool ReadVarint(uint64_t &out_value);
+        /**
+         * @brief Reads a string stored as varint length followed by its bytes.
+         *
+         * @param out_string Receives the string.
+         * @return Wether the string could be read.
+         */
+        bool ReadString(std::string &out_string);
+    };
+} // namespace tattletale
+#endif // TALE_GLOBALS_CHRONICLEARCHIVE_H
@@ -0,0 +1,192 @@
+#include "shared/chroniclecolumns.hpp"
+#include "shared/chronicle.hpp"
+#include "shared/mappedchronicle.hpp"
+#include <fstream>
+#include <vector>
+
+namespace tattletale
+{
+    namespace
+    {
+        /**
+         * @brief Collects the rows of one column and appends them to its file a whole block at a time.
+         */
+        template <typename T>
+        class ColumnWriter
+        {
+        public:
+            /**
+             * @brief Constructor opening the column file.
+             *
+             * @param prefix The prefix passed to ChronicleColumns::Write.
+             * @param name The name of the column.
+             * @param type The element type written to the schema.
+             */
+            ColumnWriter(const std::string &prefix, const char *name, const char *type)
+                : name_(name), type_(type), file_(ChronicleColumns::GetColumnPath(prefix, name), std::ios::binary | std::ios::trunc)
+            {
+                buffer_.reserve(ChronicleColumns::block_size_);
+            }
+            /**
+             * @brief Appends one row.
+             *
+             * @param value The value of the row.
+             */
+            void Push(T value)
+            {
+                buffer_.push_back(value);
+                if (buffer_.size() == ChronicleColumns::block_size_)
+                {
+                    Flush();
+                }
+            }
+            /**
+             * @brief Writes the remaining rows and checks wether everything was written.
+             *
+             * @return The result of the check.
+             */
+            bool Finish()
+            {
+                Flush();
+                file_.flush();
+                return static_cast<bool>(file_);
+            }
+            /**
+             * @brief Getter for how many rows were pushed in total.
+             *
+             * @return The amount of rows.
+             */
+            size_t GetRowCount() const
+            {
+                return row_count_ + buffer_.size();
+            }
+            /**
+             * @brief Adds the line describing the column to the schema.
+             *
+             * @param schema The schema file.
+             * @param file_prefix The prefix without its directories.
+             */
+            void WriteSchema(std::ofstream &schema, const std::string &file_prefix) const
+            {
+                schema << "column " << name_ << " " << type_ << " " << GetRowCount() << " " << ChronicleColumns::GetColumnPath(file_prefix, name_) << "\n";
+            }
+
+        private:
+            /**
+             * @brief The name of the column.
+             */
+            const char *name_;
+            /**
+             * @brief The element type written to the schema.
+             */
+            const char *type_;
+            /**
+             * @brief The opened column file.
+             */
+            std::ofstream file_;
+            /**
+             * @brief The rows that were not written yet.
+             */
+            std::vector<T> buffer_;
+            /**
+             * @brief How many rows were written to the file.
+             */
+            size_t row_count_ = 0;
+            /**
+             * @brief Writes the buffered rows to the file.
+             */
+            void Flush()
+            {
+                file_.write(reinterpret_cast<const char *>(buffer_.data()), buffer_.size() * sizeof(T));
+                row_count_ += buffer_.size();
+                buffer_.clear();
+            }
+        };
+        /**
+         * @brief The names of the KernelType values, indexed by the converted KernelType.
+         */
+        constexpr const char *kernel_type_names[] = {"none", "resource", "emotion", "relationship", "interaction", "goal"};
+        static_assert(sizeof(kernel_type_names) / sizeof(kernel_type_names[0]) == static_cast<size_t>(KernelType::kLast), "every KernelType needs a name");
+    } // namespace
+
+    bool ChronicleColumns::Write(const Chronicle &chronicle, const std::string &prefix)
+    {
+        std::ofstream schema(GetSchemaPath(prefix), std::ios::trunc);
+        if (!schema)
+        {
+            return false;
+        }
+        ColumnWriter<uint32_t> ids(prefix, "id", "uint32");
+        ColumnWriter<uint64_t> ticks(prefix, "tick", "uint64");
+        ColumnWriter<uint8_t> types(prefix, "type", "uint8");
+        ColumnWriter<uint32_t> owners(prefix, "owner", "uint32");
+        ColumnWriter<uint32_t> targets(prefix, "target", "uint32");
+        ColumnWriter<uint32_t> prototypes(prefix, "prototype", "uint32");
+        ColumnWriter<uint32_t> subtypes(prefix, "subtype", "uint32");
+        ColumnWriter<float> chances(prefix, "chance", "float32");
+        ColumnWriter<float> values(prefix, "value", "float32");
+        ColumnWriter<uint32_t> edges_from(prefix, "edge_from", "uint32");
+        ColumnWriter<uint32_t> edges_to(prefix, "edge_to", "uint32");
+
+        // spilled kernels are read back from the spill file one block at a time, so the columns also cover what happened before the spill horizon
+        auto push_kernel = [&](const SpilledKernel &kernel)
+        {
+            const MappedChronicle::KernelRecord &record = kernel.record;
+            KernelType type = static_cast<KernelType>(record.type);
+            uint32_t id = static_cast<uint32_t>(kernel.id);
+            bool is_interaction = type == KernelType::kInteraction;
+            bool has_subtype = type == KernelType::kEmotion || type == KernelType::kRelationship || type == KernelType::kGoal;
+            ids.Push(id);
+            ticks.Push(record.tick);
+            types.Push(record.type);
+            owners.Push(record.owner_id);
+            targets.Push(record.target_id);
+            prototypes.Push(is_interaction ? record.subtype : missing_id_);
+            subtypes.Push(has_subtype ? record.subtype : missing_id_);
+            chances.Push(record.chance);
+            values.Push(record.value);
+            for (auto reason_id : kernel.reason_ids)
+            {
+                edges_from.Push(static_cast<uint32_t>(reason_id));
+                edges_to.Push(id);
+            }
+        };
+        chronicle.ForEachKernel(push_kernel);
+        // & instead of && so every column gets flushed even if an earlier one failed
+        bool written = ids.Finish() & ticks.Finish() & types.Finish() & owners.Finish() & targets.Finish() & prototypes.Finish() & subtypes.Finish() & chances.Finish() & values.Finish() & edges_from.Finish() & edges_to.Finish();
+
+        // the schema refers to the columns relative to itself, so the files can be moved together
+        std::string file_prefix = prefix.substr(prefix.find_last_of("/\\") + 1);
+        schema << "tattletale_columns " << version_ << "\n";
+        schema << "kernels " << ids.GetRowCount() << "\n";
+        schema << "edges " << edges_from.GetRowCount() << "\n";
+        schema << "missing_id " << missing_id_ << "\n";
+        ids.WriteSchema(schema, file_prefix);
+        ticks.WriteSchema(schema, file_prefix);
+        types.WriteSchema(schema, file_prefix);
+        owners.WriteSchema(schema, file_prefix);
+        targets.WriteSchema(schema, file_prefix);
+        prototypes.WriteSchema(schema, file_prefix);
+        subtypes.WriteSchema(schema, file_prefix);
+        chances.WriteSchema(schema, file_prefix);
+        values.WriteSchema(schema, file_prefix);
+        edges_from.WriteSchema(schema, file_prefix);
+        edges_to.WriteSchema(schema, file_prefix);
+        for (size_t type = 0; type < static_cast<size_t>(KernelType::kLast); ++type)
+        {
+            schema << "type " << type << " " << kernel_type_names[type] << "\n";
+        }
+        schema.flush();
+        return written && static_cast<bool>(schema);
+    }
+
+    std::string ChronicleColumns::GetColumnPath(const std::string &prefix, const std::string &column)
+    {
+        return prefix + "." + column + ".bin";
+    }
+
+    std::string ChronicleColumns::GetSchemaPath(const std::string &prefix)
+    {
+        return prefix + ".schema";
+    }
+} // namespace tattletale
@@ -0,0 +1,70 @@
+#ifndef TALE_GLOBALS_CHRONICLECOLUMNS_H
+#define TALE_GLOBALS_CHRONICLECOLUMNS_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace tattletale
+{
+    class Chronicle;
+    /**
+     * @brief Exports a Chronicle as one file per column, so the \link Kernel Kernels \endlink can be loaded into column oriented analytics tools.
+     *
+     * Every column file is a headerless array of fixed size numbers in the byte order of the machine that wrote it, which e.g. numpy.fromfile can read directly.
+     * The kernel columns have one entry per Kernel, ordered by id:
+     * - id (uint32), tick (uint64), type (uint8, the converted KernelType) and owner (uint32).
+     * - target (uint32), the Actor targeted by a Relationship.
+     * - prototype (uint32), the InteractionPrototype id of an Interaction.
+     * - subtype (uint32), the converted EmotionType, RelationshipType or GoalType.
+     * - chance (float32) as returned by Kernel::GetChance and value (float32) of \link Resource Resources \endlink, \link Emotion Emotions \endlink and \link Relationship Relationships \endlink.
+     *
+     * Entries that do not apply to a KernelType are missing_id_ or 0 for the values. The edge columns edge_from and edge_to (uint32) hold one entry
+     * per reason, pointing from the reason to the Kernel it caused, ordered by the id of the caused Kernel.
+     *
+     * A small text schema next to the columns lists the amount of rows, the file, element type and row count of every column and the names of the KernelType values.
+     */
+    class ChronicleColumns
+    {
+    public:
+        /**
+         * @brief Version of the export format, written to the first line of the schema.
+         */
+        static constexpr uint32_t version_ = 1;
+        /**
+         * @brief Marks a missing id in the target, prototype and subtype columns.
+         */
+        static constexpr uint32_t missing_id_ = UINT32_MAX;
+        /**
+         * @brief How many rows each column collects before they are written in one go.
+         */
+        static constexpr size_t block_size_ = 1 << 16;
+
+        /**
+         * @brief Writes every column and the schema of a Chronicle.
+         *
+         * Spilled \link Kernel Kernels \endlink are read back through Chronicle::ForEachKernel, so they are exported like resident ones.
+         *
+         * @param chronicle The Chronicle that will be written.
+         * @param prefix Path every file name starts with, e.g. "out/chronicle" leads to "out/chronicle.schema", "out/chronicle.tick.bin" and so on. Existing files get overwritten.
+         * @return Wether every file could be written.
+         */
+        static bool Write(const Chronicle &chronicle, const std::string &prefix);
+        /**
+         * @brief Getter for the path of a column file.
+         *
+         * @param prefix The prefix passed to Write.
+         * @param column The name of the column, e.g. "tick" or "edge_from".
+         * @return The path.
+         */
+        static std::string GetColumnPath(const std::string &prefix, const std::string &column);
+        /**
+         * @brief Getter for the path of the schema file.
+         *
+         * @param prefix The prefix passed to Write.
+         * @return The path.
+         */
+        static std::string GetSchemaPath(const std::string &prefix);
+    };
+} // namespace tattletale
+#endif // TALE_GLOBALS_CHRONICLECOLUMNS_H
@@ -7,7 +7,7 @@
 namespace tattletale
 {
     Goal::Goal(GoalType type, size_t id, size_t tick, Actor *owner, std::vector<Kernel *> reasons)
-        : type_(type), Kernel(fmt::format("{}", type), id, tick, owner, reasons, KernelType::kGoal){};
+        : type_(type), Kernel(fmt::format("{}", type), id, tick, owner, std::move(reasons), KernelType::kGoal){};
 
     GoalType Goal::GetRandomGoalType(Random &random)
     {
@@ -112,43 +112,39 @@ namespace tattletale
     float Goal::CalculateChanceInfluence(const Interaction *interaction) const
     {
         float influence = 0;
-        auto &relationship_effects = interaction->GetPrototype()->relationship_effects;
+        const InteractionPrototype &prototype = *interaction->GetPrototype();
         switch (type_)
         {
         case GoalType::kWealth:
-            influence = interaction->GetPrototype()->wealth_effects[0];
+            influence = prototype.GetWealthEffect(0);
             break;
         case GoalType::kAcceptance:
             // skip first as we want the values of other people to this actor
-            for (size_t i = 1; i < relationship_effects.size(); ++i)
+            for (size_t i = 1; i < prototype.participant_count; ++i)
             {
-                if (relationship_effects[i].count(0))
-                {
-                    influence += relationship_effects[i].at(0).at(static_cast<int>(RelationshipType::kFriendship));
-                }
+                influence += prototype.GetRelationshipEffect(i, 0)[static_cast<int>(RelationshipType::kFriendship)];
             }
             break;
         case GoalType::kRelationship:
             // skip first as we want the values of other people to this actor
-            for (size_t i = 1; i < relationship_effects.size(); ++i)
+            for (size_t i = 1; i < prototype.participant_count; ++i)
             {
                 // do both sides of the relationship change
-                if (relationship_effects[i].count(0) && relationship_effects[0].count(i))
+                if (prototype.HasRelationshipEffect(i, 0) && prototype.HasRelationshipEffect(0, i))
                 {
-                    influence += relationship_effects[i].at(0).at(static_cast<int>(RelationshipType::kLove));
-                    influence += relationship_effects[0].at(1).at(static_cast<int>(RelationshipType::kLove));
+                    influence += prototype.GetRelationshipEffect(i, 0)[static_cast<int>(RelationshipType::kLove)];
+                    influence += prototype.GetRelationshipEffect(0, 1)[static_cast<int>(RelationshipType::kLove)];
                 }
             }
             break;
         case GoalType::kHedonism:
-            influence = interaction->GetPrototype()->emotion_effects[0][static_cast<int>(EmotionType::kSatisfied)];
+            influence = prototype.GetEmotionEffects(0)[static_cast<int>(EmotionType::kSatisfied)];
             break;
         case GoalType::kPower:
-            // skip first as we want the values of other people to this actor
-            for (const auto &[other_actor, effect] : relationship_effects[0])
+            for (size_t i = 0; i < prototype.participant_count; ++i)
             {
                 // using minus here because the actor wants a negative value
-                influence -= effect.at(static_cast<int>(RelationshipType::kProtective));
+                influence -= prototype.GetRelationshipEffect(0, i)[static_cast<int>(RelationshipType::kProtective)];
             }
             break;
         case GoalType::kLast:
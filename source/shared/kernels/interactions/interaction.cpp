@@ -9,35 +9,40 @@
 namespace tattletale
 {
     Interaction::Interaction(
-        const std::shared_ptr<InteractionPrototype> prototype,
-        const std::shared_ptr<InteractionRequirement> requirement,
-        const std::shared_ptr<InteractionTendency> tendency,
+        const std::shared_ptr<InteractionPrototype> &prototype,
+        const std::shared_ptr<InteractionRequirement> &requirement,
+        const std::shared_ptr<InteractionTendency> &tendency,
         float chance,
         size_t id,
         size_t tick,
         std::vector<Kernel *> reasons,
         std::vector<Actor *> participants)
-        : Kernel(prototype->name, id, tick, participants[0], reasons, KernelType::kInteraction),
+        : Kernel(prototype->name, id, tick, participants[0], std::move(reasons), KernelType::kInteraction),
           prototype_(prototype),
           requirement_(requirement),
           tendency_(tendency),
           chance_(chance),
-          participants_(participants){};
+          participants_(std::move(participants)){};
 
     void Interaction::Apply()
     {
-        std::vector<Kernel *> reasons{this};
         for (size_t i = 0; i < participants_.size(); ++i)
         {
-            participants_.at(i)->ApplyWealthChange(reasons, tick_, prototype_->wealth_effects[i]);
-            for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+            participants_.at(i)->ApplyWealthChange(this, tick_, prototype_->GetWealthEffect(i));
+            if (prototype_->HasEmotionEffect(i))
             {
-                float value = prototype_->emotion_effects[i][type_index];
-                participants_.at(i)->ApplyEmotionChange(reasons, tick_, type_index, value);
+                const float *emotion_effects = prototype_->GetEmotionEffects(i);
+                for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+                {
+                    participants_.at(i)->ApplyEmotionChange(this, tick_, type_index, emotion_effects[type_index]);
+                }
             }
-            for (auto &[other, change] : prototype_->relationship_effects[i])
+            for (size_t other = 0; other < participants_.size(); ++other)
             {
-                participants_.at(i)->ApplyRelationshipChange(reasons, tick_, participants_[other]->id_, change);
+                if (prototype_->HasRelationshipEffect(i, other))
+                {
+                    participants_.at(i)->ApplyRelationshipChange(this, tick_, participants_[other]->id_, prototype_->GetRelationshipEffect(i, other));
+                }
             }
         }
     }
@@ -101,6 +106,10 @@ namespace tattletale
     {
         return participants_;
     }
+    const std::vector<Actor *> &Interaction::GetParticipants() const
+    {
+        return participants_;
+    }
 
     float Interaction::GetChance() const
     {
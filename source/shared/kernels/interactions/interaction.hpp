@@ -81,6 +81,12 @@ namespace tattletale
          * @return The participants.
          */
         virtual std::vector<Actor *> GetAllParticipants() const override;
+        /**
+         * @brief Getter for the participants this Interaction uses that does not copy them.
+         *
+         * @return A Reference to the participants.
+         */
+        const std::vector<Actor *> &GetParticipants() const;
         /**
          * @brief Overriden getter for the chance this Interaction had when it was chosen.
          *
@@ -121,9 +127,9 @@ namespace tattletale
          * @param participants Vector of \link Actor Actors \endlink that are participating in this Interaction.
          **/
         Interaction(
-            const std::shared_ptr<InteractionPrototype> Prototype,
-            const std::shared_ptr<InteractionRequirement> requirement,
-            const std::shared_ptr<InteractionTendency> tendency,
+            const std::shared_ptr<InteractionPrototype> &Prototype,
+            const std::shared_ptr<InteractionRequirement> &requirement,
+            const std::shared_ptr<InteractionTendency> &tendency,
             float chance,
             size_t id,
             size_t tick,
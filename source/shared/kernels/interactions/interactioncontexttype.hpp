@@ -1,6 +1,7 @@
 #ifndef TALE_INTERACTIONS_INTERACTIONCONTEXTTYPE_H
 #define TALE_INTERACTIONS_INTERACTIONCONTEXTTYPE_H
 #include <string>
+#include <array>
 namespace tattletale
 {
     /**
@@ -12,6 +13,10 @@ namespace tattletale
         kFreetime,
         kLast
     };
+    /**
+     * @brief One value per ContextType, indexed by the converted ContextType.
+     */
+    using ContextValues = std::array<float, static_cast<size_t>(ContextType::kLast)>;
 
     /**
      * @brief Converts a string to an ContextType.
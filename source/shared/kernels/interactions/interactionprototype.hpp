@@ -3,10 +3,11 @@
 
 #include <string>
 #include <vector>
+#include <algorithm>
 #include "shared/kernels/resourcekernels/emotion.hpp"
 #include "shared/kernels/resourcekernels/relationship.hpp"
 #include <fmt/core.h>
-#include <robin_hood.h>
+#include <cstdint>
 
 namespace tattletale
 {
@@ -53,21 +54,177 @@ namespace tattletale
          * @brief The active description of this protoype.
          */
         std::string active_description = "";
+        /**
+         * @brief How many values each entry of emotion_effects consists of, one per EmotionType.
+         */
+        static constexpr size_t emotion_type_count_ = static_cast<size_t>(EmotionType::kLast);
+        /**
+         * @brief How many values each entry of relationship_effects consists of, one per RelationshipType.
+         */
+        static constexpr size_t relationship_type_count_ = static_cast<size_t>(RelationshipType::kLast);
+        /**
+         * @brief Eight consecutive effect values, aligned so a block fills exactly one 256 bit vector register.
+         */
+        struct alignas(32) EffectBlock
+        {
+            float values[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        };
+        /**
+         * @brief How many values one EffectBlock holds.
+         */
+        static constexpr size_t effect_block_size_ = sizeof(EffectBlock::values) / sizeof(float);
+        static_assert(emotion_type_count_ <= effect_block_size_ && relationship_type_count_ <= effect_block_size_, "The effects on one participant have to fit into one EffectBlock");
+        /**
+         * @brief How many participants the effects are sized for. Set through SetParticipantCount.
+         */
+        size_t participant_count = 0;
         /**
          * @brief Stores the effect the corresponding Interaction has on each participating \link Actor Actor's \endlink wealth.
+         *
+         * The values of all participants are stored consecutively, effect_block_size_ per EffectBlock. Read through GetWealthEffect.
+         */
+        std::vector<EffectBlock> wealth_effects;
+        /**
+         * @brief Stores the effect the corresponding Interaction has on each participating \link Actor Actor's \endlink \link Emotion Emotions \endlink.
+         *
+         * One EffectBlock per participant, indexed by EmotionType index. The lanes behind emotion_type_count_ stay zero.
          */
-        std::vector<float> wealth_effects;
+        std::vector<EffectBlock> emotion_effects;
         /**
-         * @brief Stores the effect the corresponding Interaction Interaction has on each participating \link Actor Actor's \endlink \link Emotion Emotions \endlink.
+         * @brief Holds for each participant wether any of its \link Emotion Emotional \endlink effects is not zero.
          */
-        std::vector<std::vector<float>> emotion_effects;
+        std::vector<uint8_t> emotion_effect_mask;
         /**
          * @brief Stores the effect the corresponding Interaction has on each participating \link Actor Actor's \endlink \link Relationship Relationships \endlink.
          *
-         * For each Actor a map is created that maps an index in the participants_ vector to another vector of floats, which indices correspond to the RelationshipType enum.
-         * Those pairs signal how much each Relationship axis would be changed.
+         * A participant x participant matrix of EffectBlocks indexed by participant index * participant_count + other participant index, each indexed by RelationshipType index.
+         * Only the entries marked in relationship_effect_mask are defined by the catalogue, all others are zero.
+         */
+        std::vector<EffectBlock> relationship_effects;
+        /**
+         * @brief Holds for each pair of participants wether the Interaction has a Relationship effect between them. Indexed by participant index * participant_count + other participant index.
+         */
+        std::vector<uint8_t> relationship_effect_mask;
+
+        /**
+         * @brief Sizes all effects for the passed amount of participants and sets them to zero.
+         *
+         * @param participant_count How many participants the Interaction has.
+         */
+        void SetParticipantCount(size_t participant_count)
+        {
+            this->participant_count = participant_count;
+            wealth_effects.assign((participant_count + effect_block_size_ - 1) / effect_block_size_, EffectBlock());
+            emotion_effects.assign(participant_count, EffectBlock());
+            emotion_effect_mask.assign(participant_count, 0);
+            relationship_effects.assign(participant_count * participant_count, EffectBlock());
+            relationship_effect_mask.assign(participant_count * participant_count, 0);
+        }
+        /**
+         * @brief Getter for the effect on the wealth of one participant.
+         *
+         * @param participant_index The index of the participant.
+         * @return The effect.
+         */
+        float GetWealthEffect(size_t participant_index) const
+        {
+            return wealth_effects[participant_index / effect_block_size_].values[participant_index % effect_block_size_];
+        }
+        /**
+         * @brief Sets the effect on the wealth of one participant.
+         *
+         * @param participant_index The index of the participant.
+         * @param value The effect.
+         */
+        void SetWealthEffect(size_t participant_index, float value)
+        {
+            wealth_effects[participant_index / effect_block_size_].values[participant_index % effect_block_size_] = value;
+        }
+        /**
+         * @brief Getter for the \link Emotion Emotional \endlink effects on one participant.
+         *
+         * @param participant_index The index of the participant.
+         * @return Pointer to emotion_type_count_ values indexed by EmotionType, aligned to 32 bytes.
+         */
+        const float *GetEmotionEffects(size_t participant_index) const
+        {
+            return emotion_effects[participant_index].values;
+        }
+        /**
+         * @brief Checks wether the Interaction changes any Emotion of one participant.
+         *
+         * @param participant_index The index of the participant.
+         * @return The result of the check.
+         */
+        bool HasEmotionEffect(size_t participant_index) const
+        {
+            return emotion_effect_mask[participant_index];
+        }
+        /**
+         * @brief Sets the effect on one Emotion of one participant and marks the participant if the effect is not zero.
+         *
+         * @param participant_index The index of the participant.
+         * @param type_index The index of the EmotionType.
+         * @param value The effect.
          */
-        std::vector<robin_hood::unordered_map<size_t, std::vector<float>>> relationship_effects;
+        void SetEmotionEffect(size_t participant_index, int type_index, float value)
+        {
+            emotion_effects[participant_index].values[type_index] = value;
+            if (value != 0)
+            {
+                emotion_effect_mask[participant_index] = 1;
+            }
+        }
+        /**
+         * @brief Checks wether the Interaction changes the Relationship of one participant to another.
+         *
+         * @param participant_index The index of the participant owning the Relationship.
+         * @param other_participant_index The index of the participant the Relationship is directed at.
+         * @return The result of the check.
+         */
+        bool HasRelationshipEffect(size_t participant_index, size_t other_participant_index) const
+        {
+            return relationship_effect_mask[participant_index * participant_count + other_participant_index];
+        }
+        /**
+         * @brief Getter for the effect on the Relationship of one participant to another.
+         *
+         * @param participant_index The index of the participant owning the Relationship.
+         * @param other_participant_index The index of the participant the Relationship is directed at.
+         * @return Pointer to relationship_type_count_ values indexed by RelationshipType, aligned to 32 bytes. All zero if HasRelationshipEffect is false.
+         */
+        const float *GetRelationshipEffect(size_t participant_index, size_t other_participant_index) const
+        {
+            return relationship_effects[participant_index * participant_count + other_participant_index].values;
+        }
+        /**
+         * @brief Sets the effect on the Relationship of one participant to another and marks it as defined.
+         *
+         * @param participant_index The index of the participant owning the Relationship.
+         * @param other_participant_index The index of the participant the Relationship is directed at.
+         * @param values One value per RelationshipType.
+         */
+        void SetRelationshipEffect(size_t participant_index, size_t other_participant_index, const RelationshipValues &values)
+        {
+            size_t pair_index = participant_index * participant_count + other_participant_index;
+            std::copy(values.begin(), values.end(), relationship_effects[pair_index].values);
+            relationship_effect_mask[pair_index] = 1;
+        }
+        /**
+         * @brief Counts the \link Relationship Relationships \endlink of one participant the Interaction changes.
+         *
+         * @param participant_index The index of the participant owning the \link Relationship Relationships \endlink.
+         * @return The amount of defined Relationship effects.
+         */
+        size_t GetRelationshipEffectCount(size_t participant_index) const
+        {
+            size_t count = 0;
+            for (size_t other_participant_index = 0; other_participant_index < participant_count; ++other_participant_index)
+            {
+                count += relationship_effect_mask[participant_index * participant_count + other_participant_index];
+            }
+            return count;
+        }
 
         /**
          * @brief Reset all values back to their default state.
@@ -79,9 +236,12 @@ namespace tattletale
             fluff = false;
             angst = false;
             sexual = false;
+            participant_count = 0;
             wealth_effects.clear();
             emotion_effects.clear();
+            emotion_effect_mask.clear();
             relationship_effects.clear();
+            relationship_effect_mask.clear();
         }
     };
 
@@ -110,34 +270,39 @@ struct fmt::formatter<T, std::enable_if_t<std::is_base_of<tattletale::Interactio
     {
         std::string name_string = fmt::format("Name: {}\n", prototype.name);
         std::string wealth_effects_string = "";
-        for (size_t i = 0; i < prototype.wealth_effects.size(); ++i)
+        for (size_t i = 0; i < prototype.participant_count; ++i)
         {
-            wealth_effects_string += fmt::format("\t{}. Wealth Effect: {}\n", i, prototype.wealth_effects[i]);
+            wealth_effects_string += fmt::format("\t{}. Wealth Effect: {}\n", i, prototype.GetWealthEffect(i));
         }
         std::string emotion_effects_string = "";
-        for (size_t i = 0; i < prototype.emotion_effects.size(); ++i)
+        for (size_t i = 0; i < prototype.participant_count; ++i)
         {
             emotion_effects_string += fmt::format("\t{}. Emotion Effect:", i);
 
-            for (int type_index = 0; type_index < prototype.emotion_effects[i].size(); ++type_index)
+            for (int type_index = 0; type_index < prototype.emotion_type_count_; ++type_index)
             {
-                float value = prototype.emotion_effects[i][type_index];
+                float value = prototype.GetEmotionEffects(i)[type_index];
                 tattletale::EmotionType type = static_cast<tattletale::EmotionType>(type_index);
                 emotion_effects_string += fmt::format("\n\t\t{}: {}", type, value);
             }
             emotion_effects_string += "\n";
         }
         std::string relationship_effects_string = "";
-        for (size_t i = 0; i < prototype.relationship_effects.size(); ++i)
+        for (size_t i = 0; i < prototype.participant_count; ++i)
         {
             relationship_effects_string += fmt::format("\tRelationship Effects for Participant {}:", i);
-            for (auto &[other_participant, relationship_vector] : prototype.relationship_effects[i])
+            for (size_t other_participant = 0; other_participant < prototype.participant_count; ++other_participant)
             {
+                if (!prototype.HasRelationshipEffect(i, other_participant))
+                {
+                    continue;
+                }
                 relationship_effects_string += fmt::format("\n\t\tWith Participant {}:", other_participant);
-                for (int type_index = 0; type_index < relationship_vector.size(); ++type_index)
+                const float *relationship_values = prototype.GetRelationshipEffect(i, other_participant);
+                for (int type_index = 0; type_index < prototype.relationship_type_count_; ++type_index)
                 {
                     tattletale::RelationshipType type = static_cast<tattletale::RelationshipType>(type_index);
-                    relationship_effects_string += fmt::format("\n\t\t\t{}: {}", type, relationship_vector[type_index]);
+                    relationship_effects_string += fmt::format("\n\t\t\t{}: {}", type, relationship_values[type_index]);
                 }
             }
             relationship_effects_string += "\n";
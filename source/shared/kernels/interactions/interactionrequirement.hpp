@@ -30,12 +30,12 @@ namespace tattletale
         /**
          * @brief What emotions the participating Actors have to have for the Interaction to happen.
          */
-        std::vector<std::vector<float>> emotions;
+        std::vector<EmotionValues> emotions;
 
         /**
          * @brief What relationship the Actor has to have with the participants he chooses.
          */
-        std::vector<std::vector<float>> relationship;
+        std::vector<RelationshipValues> relationship;
 
         /**
          * @brief Reset all values back to their default state.
@@ -55,11 +55,11 @@ namespace tattletale
             this->participant_count = participant_count;
             for (size_t i = 0; i < participant_count; ++i)
             {
-                emotions.push_back(std::vector<float>(static_cast<int>(EmotionType::kLast), 0.0f));
+                emotions.push_back(EmotionValues{});
             }
             for (size_t active_participant = 1; active_participant < participant_count; ++active_participant)
             {
-                relationship.push_back(std::vector<float>(static_cast<int>(RelationshipType::kLast), 0.0f));
+                relationship.push_back(RelationshipValues{});
             }
         }
         /**
@@ -14,9 +14,9 @@ namespace tattletale
     struct InteractionTendency
     {
         /**
-         * @brief Vector of floats, which indices map to the ContextType enum, that stores how the current Context might influence the choice.
+         * @brief Stores how the current Context might influence the choice, indexed by ContextType.
          */
-        std::vector<float> contexts = std::vector<float>(static_cast<int>(ContextType::kLast), 0.0f);
+        ContextValues contexts = {};
 
         /**
          * @brief Stores how the wealth of the Actor influences the choice.
@@ -25,20 +25,20 @@ namespace tattletale
         /**
          * @brief Stores how the wealth of the Actor influences the choice.
          */
-        std::vector<float> emotions = std::vector<float>(static_cast<int>(EmotionType::kLast), 0.0f);
+        EmotionValues emotions = {};
         /**
          * @brief Stores how the relationship to each participant influences how likely the Actor is to pick them for this role.
          */
-        std::vector<std::vector<float>> relationships = {};
+        std::vector<RelationshipValues> relationships = {};
 
         /**
          * @brief Reset all values back to their default state.
          */
         void ClearValues()
         {
-            contexts = std::vector<float>(static_cast<int>(ContextType::kLast), 0.0f);
+            contexts.fill(0.0f);
             wealth = 0;
-            emotions = std::vector<float>(static_cast<int>(EmotionType::kLast), 0.0f);
+            emotions.fill(0.0f);
             relationships.clear();
         }
     };
@@ -3,6 +3,7 @@
 #include "shared/kernels/kernel.hpp"
 
 #include <iostream>
+#include <algorithm>
 
 namespace tattletale
 {
@@ -12,11 +13,11 @@ namespace tattletale
         Actor *owner,
         std::vector<Kernel *> reasons,
         KernelType type)
-        : name_(name),
+        : name_(std::move(name)),
           id_(id),
           tick_(tick),
           owner_(owner),
-          reasons_(reasons),
+          reasons_(std::move(reasons)),
           type_(type)
     {
     }
@@ -30,6 +31,13 @@ namespace tattletale
     {
         return consequences_;
     }
+    void Kernel::RemoveLinks(const std::function<bool(size_t)> &is_removed)
+    {
+        auto is_removed_kernel = [&](const Kernel *kernel)
+        { return is_removed(kernel->id_); };
+        reasons_.erase(std::remove_if(reasons_.begin(), reasons_.end(), is_removed_kernel), reasons_.end());
+        consequences_.erase(std::remove_if(consequences_.begin(), consequences_.end(), is_removed_kernel), consequences_.end());
+    }
 
     float Kernel::GetChance() const { return 1.0f; }
 
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <fmt/core.h>
 #include <fmt/format.h>
 
@@ -69,6 +70,14 @@ namespace tattletale
          * @return The vector of consequences.
          */
         const std::vector<Kernel *> &GetConsequences() const;
+        /**
+         * @brief Removes every reason and consequence of this Kernel whose id fulfills the passed condition.
+         *
+         * Used by the Chronicle to cut the links to \link Kernel Kernels \endlink that get spilled to disk.
+         *
+         * @param is_removed Gets the id of each linked Kernel and returns wether the link should be removed.
+         */
+        void RemoveLinks(const std::function<bool(size_t)> &is_removed);
         /**
          * @brief Gets the \link Kernel Kernels \endlink that were the reason for the creation of this Kernel.
          *
@@ -14,7 +14,7 @@ namespace tattletale
               id,
               tick,
               owner,
-              reasons,
+              std::move(reasons),
               value,
               KernelType::kEmotion,
               Verb("felt", "feeling", "feel")),
@@ -35,7 +35,7 @@ namespace tattletale
         TATTLETALE_ERROR_PRINT(true, "Invalid Emotion string was passed");
         return EmotionType::kLast;
     }
-    EmotionType Emotion::GetType()
+    EmotionType Emotion::GetType() const
     {
         return type_;
     }
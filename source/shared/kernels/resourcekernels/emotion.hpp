@@ -2,6 +2,7 @@
 #define TALE_KERNELS_RESOURCEKERNELS_EMOTION_H
 
 #include <string>
+#include <array>
 #include "shared/kernels/resourcekernels/resource.hpp"
 
 namespace tattletale
@@ -18,6 +19,10 @@ namespace tattletale
         kExtroverted,
         kLast
     };
+    /**
+     * @brief One value per EmotionType, indexed by the converted EmotionType.
+     */
+    using EmotionValues = std::array<float, static_cast<size_t>(EmotionType::kLast)>;
 
     /**
      * @brief Represents an Emotion an Actor has.
@@ -46,7 +51,7 @@ namespace tattletale
          *
          * @return The EmotionType.
          */
-        EmotionType GetType();
+        EmotionType GetType() const;
 
         // TODO: documentation
         virtual float CalculateChanceInfluence(const Interaction *interaction) const override;
@@ -14,7 +14,7 @@ namespace tattletale
               id,
               tick,
               owner,
-              reasons,
+              std::move(reasons),
               value,
               KernelType::kRelationship,
               Verb("felt", "feeling", "feel")),
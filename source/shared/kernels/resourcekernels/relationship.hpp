@@ -1,6 +1,7 @@
 #ifndef TALE_KERNELS_RESOURCEKERNELS_RELATIONSHIP_H
 #define TALE_KERNELS_RESOURCEKERNELS_RELATIONSHIP_H
 
+#include <array>
 #include "shared/kernels/resourcekernels/resource.hpp"
 
 namespace tattletale
@@ -17,6 +18,10 @@ namespace tattletale
         kProtective,
         kLast
     };
+    /**
+     * @brief One value per RelationshipType, indexed by the converted RelationshipType.
+     */
+    using RelationshipValues = std::array<float, static_cast<size_t>(RelationshipType::kLast)>;
     /**
      * @brief Represents a Relationship an Actor has with another Actor
      *
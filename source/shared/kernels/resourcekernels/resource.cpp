@@ -17,11 +17,11 @@ namespace tattletale
         float value,
         KernelType type,
         Verb verb)
-        : Kernel(name, id, tick, owner, reasons, type),
-          positive_name_variant_(positive_name_variant),
-          negative_name_variant_(negative_name_variant),
+        : Kernel(std::move(name), id, tick, owner, std::move(reasons), type),
+          positive_name_variant_(std::move(positive_name_variant)),
+          negative_name_variant_(std::move(negative_name_variant)),
           value_(value),
-          verb_(verb){};
+          verb_(std::move(verb)){};
     Resource::~Resource() {}
     float Resource::GetValue() const
     {
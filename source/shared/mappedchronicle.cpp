@@ -0,0 +1,525 @@
+#include "shared/mappedchronicle.hpp"
+#include "shared/chronicle.hpp"
+#include "shared/actor.hpp"
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+#include <robin_hood.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tattletale
+{
+    namespace
+    {
+        /**
+         * @brief Collects the strings of a file so that each one is only stored once.
+         */
+        class StringTable
+        {
+        public:
+            /**
+             * @brief Adds a string if it is not part of the table yet.
+             *
+             * @param value The string.
+             * @return Offset of the string in the table.
+             */
+            uint32_t Intern(const std::string &value)
+            {
+                auto it = offsets_.find(value);
+                if (it != offsets_.end())
+                {
+                    return it->second;
+                }
+                uint32_t offset = static_cast<uint32_t>(data_.size());
+                data_.insert(data_.end(), value.begin(), value.end());
+                data_.push_back('\0');
+                offsets_.emplace(value, offset);
+                return offset;
+            }
+            /**
+             * @brief Getter for the concatenated strings.
+             *
+             * @return The table.
+             */
+            const std::vector<char> &GetData() const
+            {
+                return data_;
+            }
+
+        private:
+            /**
+             * @brief Every string followed by '\0'.
+             */
+            std::vector<char> data_;
+            /**
+             * @brief Maps each string to its offset in data_.
+             */
+            robin_hood::unordered_map<std::string, uint32_t> offsets_;
+        };
+        /**
+         * @brief Builds one compressed sparse row section.
+         */
+        struct SparseRows
+        {
+            /**
+             * @brief Row count + 1 offsets into ids.
+             */
+            std::vector<uint32_t> offsets = {0};
+            /**
+             * @brief The ids of every row after each other.
+             */
+            std::vector<uint32_t> ids;
+            /**
+             * @brief Ends the current row.
+             */
+            void EndRow()
+            {
+                offsets.push_back(static_cast<uint32_t>(ids.size()));
+            }
+        };
+    } // namespace
+
+    MappedChronicle::KernelRecord MappedChronicle::CreateKernelRecord(Kernel *kernel, uint32_t name)
+    {
+        KernelRecord record = {};
+        record.tick = kernel->tick_;
+        record.owner_id = static_cast<uint32_t>(kernel->GetOwner()->id_);
+        record.name = name;
+        record.subtype = 0;
+        record.target_id = no_id_;
+        record.value = 0;
+        record.chance = kernel->GetChance();
+        record.type = static_cast<uint8_t>(kernel->type_);
+        switch (kernel->type_)
+        {
+        case KernelType::kResource:
+            record.value = dynamic_cast<Resource *>(kernel)->GetValue();
+            break;
+        case KernelType::kEmotion:
+            record.subtype = static_cast<uint32_t>(dynamic_cast<Emotion *>(kernel)->GetType());
+            record.value = dynamic_cast<Resource *>(kernel)->GetValue();
+            break;
+        case KernelType::kRelationship:
+            record.subtype = static_cast<uint32_t>(dynamic_cast<Relationship *>(kernel)->GetType());
+            record.value = dynamic_cast<Resource *>(kernel)->GetValue();
+            record.target_id = static_cast<uint32_t>(kernel->GetAllParticipants()[1]->id_);
+            break;
+        case KernelType::kGoal:
+            record.subtype = static_cast<uint32_t>(dynamic_cast<Goal *>(kernel)->type_);
+            break;
+        case KernelType::kInteraction:
+            record.subtype = static_cast<uint32_t>(dynamic_cast<Interaction *>(kernel)->GetPrototype()->id);
+            break;
+        default:
+            break;
+        }
+        return record;
+    }
+
+    bool MappedChronicle::Write(const Chronicle &chronicle, const std::string &path)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        size_t kernel_count = chronicle.GetKernelAmount();
+        const std::vector<Actor *> &actors = chronicle.actors_;
+        Header header = {};
+        std::memcpy(header.magic, magic_, sizeof(magic_));
+        header.version = version_;
+        header.header_size = sizeof(Header);
+        header.kernel_count = kernel_count;
+        header.actor_count = actors.size();
+        uint64_t position = 0;
+        auto write_section = [&](const void *section, size_t size) -> uint64_t
+        {
+            static const char padding[8] = {};
+            uint64_t offset = position;
+            file.write(reinterpret_cast<const char *>(section), size);
+            size_t padding_size = (8 - size % 8) % 8;
+            file.write(padding, padding_size);
+            position += size + padding_size;
+            return offset;
+        };
+        // the offsets are only known at the end, so the header gets written a second time
+        write_section(&header, sizeof(Header));
+
+        // the records are written while the kernels are visited in id order, spilled ones are read back one block at a time
+        // so only the rows of ids are held in memory, they are needed to invert the reasons into consequences
+        static_assert(sizeof(KernelRecord) % 8 == 0, "the record section needs no padding");
+        header.kernels_offset = position;
+        StringTable strings;
+        SparseRows reasons;
+        SparseRows participants;
+        std::vector<SparseRows> kernels_by_actor(actors.size());
+        std::vector<KernelRecord> record_buffer;
+        record_buffer.reserve(record_buffer_size_);
+        auto flush_records = [&]()
+        {
+            write_section(record_buffer.data(), record_buffer.size() * sizeof(KernelRecord));
+            record_buffer.clear();
+        };
+        auto add_kernel = [&](const SpilledKernel &kernel)
+        {
+            KernelRecord record = kernel.record;
+            record.name = strings.Intern(kernel.name);
+            record_buffer.push_back(record);
+            if (record_buffer.size() == record_buffer_size_)
+            {
+                flush_records();
+            }
+
+            for (auto reason_id : kernel.reason_ids)
+            {
+                reasons.ids.push_back(static_cast<uint32_t>(reason_id));
+            }
+            reasons.EndRow();
+            for (auto participant_id : kernel.participant_ids)
+            {
+                participants.ids.push_back(static_cast<uint32_t>(participant_id));
+            }
+            participants.EndRow();
+
+            // same rule as the Chronicle: interactions belong to every participant, everything else only to its owner
+            if (record.type == static_cast<uint8_t>(KernelType::kInteraction))
+            {
+                for (auto participant_id : kernel.participant_ids)
+                {
+                    kernels_by_actor[participant_id].ids.push_back(static_cast<uint32_t>(kernel.id));
+                }
+            }
+            else
+            {
+                kernels_by_actor[record.owner_id].ids.push_back(static_cast<uint32_t>(kernel.id));
+            }
+        };
+        chronicle.ForEachKernel(add_kernel);
+        flush_records();
+        // a kernel is a consequence of each of its reasons, the consequences of a reason are ordered by id just like the ones the Chronicle keeps
+        SparseRows consequences;
+        consequences.offsets.assign(kernel_count + 1, 0);
+        for (auto reason_id : reasons.ids)
+        {
+            ++consequences.offsets[reason_id + 1];
+        }
+        for (size_t kernel_id = 0; kernel_id < kernel_count; ++kernel_id)
+        {
+            consequences.offsets[kernel_id + 1] += consequences.offsets[kernel_id];
+        }
+        consequences.ids.resize(reasons.ids.size());
+        std::vector<uint32_t> next_consequence(consequences.offsets.begin(), consequences.offsets.end() - 1);
+        for (size_t kernel_id = 0; kernel_id < kernel_count; ++kernel_id)
+        {
+            for (size_t reason_index = reasons.offsets[kernel_id]; reason_index < reasons.offsets[kernel_id + 1]; ++reason_index)
+            {
+                consequences.ids[next_consequence[reasons.ids[reason_index]]++] = static_cast<uint32_t>(kernel_id);
+            }
+        }
+        SparseRows actor_kernels;
+        std::vector<ActorRecord> actor_records(actors.size());
+        for (size_t actor_id = 0; actor_id < actors.size(); ++actor_id)
+        {
+            const auto &ids = kernels_by_actor[actor_id].ids;
+            actor_kernels.ids.insert(actor_kernels.ids.end(), ids.begin(), ids.end());
+            actor_kernels.EndRow();
+            actor_records[actor_id].first_name = strings.Intern(actors[actor_id]->first_name_);
+            actor_records[actor_id].last_name = strings.Intern(actors[actor_id]->last_name_);
+        }
+
+        header.reason_offsets_offset = write_section(reasons.offsets.data(), reasons.offsets.size() * sizeof(uint32_t));
+        header.reasons_offset = write_section(reasons.ids.data(), reasons.ids.size() * sizeof(uint32_t));
+        header.consequence_offsets_offset = write_section(consequences.offsets.data(), consequences.offsets.size() * sizeof(uint32_t));
+        header.consequences_offset = write_section(consequences.ids.data(), consequences.ids.size() * sizeof(uint32_t));
+        header.participant_offsets_offset = write_section(participants.offsets.data(), participants.offsets.size() * sizeof(uint32_t));
+        header.participants_offset = write_section(participants.ids.data(), participants.ids.size() * sizeof(uint32_t));
+        header.actor_kernel_offsets_offset = write_section(actor_kernels.offsets.data(), actor_kernels.offsets.size() * sizeof(uint32_t));
+        header.actor_kernels_offset = write_section(actor_kernels.ids.data(), actor_kernels.ids.size() * sizeof(uint32_t));
+        header.actors_offset = write_section(actor_records.data(), actor_records.size() * sizeof(ActorRecord));
+        header.strings_size = strings.GetData().size();
+        header.strings_offset = write_section(strings.GetData().data(), strings.GetData().size());
+        header.file_size = position;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+        return static_cast<bool>(file);
+    }
+
+    MappedChronicle::~MappedChronicle()
+    {
+        Close();
+    }
+
+    bool MappedChronicle::Open(const std::string &path)
+    {
+        Close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!data)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+        file_handle_ = file;
+        mapping_handle_ = mapping;
+        size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+        int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+        struct stat file_status;
+        if (fstat(file, &file_status) != 0 || file_status.st_size == 0)
+        {
+            close(file);
+            return false;
+        }
+        void *data = mmap(nullptr, static_cast<size_t>(file_status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        // the mapping keeps the file alive on its own
+        close(file);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+        size_ = static_cast<size_t>(file_status.st_size);
+#endif
+        data_ = static_cast<const unsigned char *>(data);
+        if (!IsValid())
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedChronicle::Close()
+    {
+        if (!data_)
+        {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_handle_);
+        CloseHandle(file_handle_);
+        mapping_handle_ = nullptr;
+        file_handle_ = nullptr;
+#else
+        munmap(const_cast<unsigned char *>(data_), size_);
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    bool MappedChronicle::IsOpen() const
+    {
+        return data_ != nullptr;
+    }
+
+    size_t MappedChronicle::GetKernelAmount() const
+    {
+        return GetHeader().kernel_count;
+    }
+
+    size_t MappedChronicle::GetActorAmount() const
+    {
+        return GetHeader().actor_count;
+    }
+
+    const MappedChronicle::KernelRecord &MappedChronicle::GetKernel(size_t kernel_id) const
+    {
+        return GetSection<KernelRecord>(GetHeader().kernels_offset)[kernel_id];
+    }
+
+    KernelType MappedChronicle::GetKernelType(size_t kernel_id) const
+    {
+        return static_cast<KernelType>(GetKernel(kernel_id).type);
+    }
+
+    const char *MappedChronicle::GetKernelName(size_t kernel_id) const
+    {
+        return GetSection<char>(GetHeader().strings_offset) + GetKernel(kernel_id).name;
+    }
+
+    MappedChronicle::IdRange MappedChronicle::GetReasons(size_t kernel_id) const
+    {
+        return GetRow(GetHeader().reason_offsets_offset, GetHeader().reasons_offset, kernel_id);
+    }
+
+    MappedChronicle::IdRange MappedChronicle::GetConsequences(size_t kernel_id) const
+    {
+        return GetRow(GetHeader().consequence_offsets_offset, GetHeader().consequences_offset, kernel_id);
+    }
+
+    MappedChronicle::IdRange MappedChronicle::GetParticipants(size_t kernel_id) const
+    {
+        return GetRow(GetHeader().participant_offsets_offset, GetHeader().participants_offset, kernel_id);
+    }
+
+    MappedChronicle::IdRange MappedChronicle::GetActorKernels(size_t actor_id) const
+    {
+        return GetRow(GetHeader().actor_kernel_offsets_offset, GetHeader().actor_kernels_offset, actor_id);
+    }
+
+    std::string MappedChronicle::GetActorName(size_t actor_id) const
+    {
+        const ActorRecord &actor = GetSection<ActorRecord>(GetHeader().actors_offset)[actor_id];
+        const char *strings = GetSection<char>(GetHeader().strings_offset);
+        return std::string(strings + actor.first_name) + " " + (strings + actor.last_name);
+    }
+
+    size_t MappedChronicle::GetLastTick() const
+    {
+        size_t kernel_count = GetKernelAmount();
+        return (kernel_count == 0 ? 0 : GetKernel(kernel_count - 1).tick);
+    }
+
+    uint32_t MappedChronicle::GetLastEmotionOfType(size_t tick, size_t actor_id, EmotionType type) const
+    {
+        return FindLastOfActorBeforeTick(tick, actor_id, KernelType::kEmotion, static_cast<uint32_t>(type));
+    }
+
+    uint32_t MappedChronicle::GetLastWealth(size_t tick, size_t actor_id) const
+    {
+        return FindLastOfActorBeforeTick(tick, actor_id, KernelType::kResource, no_id_);
+    }
+
+    void MappedChronicle::Prefetch(size_t first_kernel_id, size_t end_kernel_id) const
+    {
+        AdviseKernels(first_kernel_id, end_kernel_id, true);
+    }
+
+    void MappedChronicle::Release(size_t first_kernel_id, size_t end_kernel_id) const
+    {
+        AdviseKernels(first_kernel_id, end_kernel_id, false);
+    }
+
+    const MappedChronicle::Header &MappedChronicle::GetHeader() const
+    {
+        return *reinterpret_cast<const Header *>(data_);
+    }
+
+    MappedChronicle::IdRange MappedChronicle::GetRow(uint64_t offsets_offset, uint64_t ids_offset, size_t row) const
+    {
+        const uint32_t *offsets = GetSection<uint32_t>(offsets_offset);
+        const uint32_t *ids = GetSection<uint32_t>(ids_offset);
+        return {ids + offsets[row], ids + offsets[row + 1]};
+    }
+
+    void MappedChronicle::AdviseKernels(size_t first_kernel_id, size_t end_kernel_id, bool will_need) const
+    {
+#ifndef _WIN32
+        end_kernel_id = std::min(end_kernel_id, GetKernelAmount());
+        if (first_kernel_id >= end_kernel_id)
+        {
+            return;
+        }
+        const Header &header = GetHeader();
+        size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        auto advise = [&](uint64_t begin, uint64_t end)
+        {
+            // prefetching covers every touched page, releasing only pages no other kernel shares
+            uint64_t first_page = (will_need ? begin / page_size : (begin + page_size - 1) / page_size);
+            uint64_t end_page = (will_need ? (end + page_size - 1) / page_size : end / page_size);
+            end_page = std::min<uint64_t>(end_page, (size_ + page_size - 1) / page_size);
+            if (first_page >= end_page)
+            {
+                return;
+            }
+            madvise(const_cast<unsigned char *>(data_) + first_page * page_size, (end_page - first_page) * page_size, (will_need ? MADV_WILLNEED : MADV_DONTNEED));
+        };
+        advise(header.kernels_offset + first_kernel_id * sizeof(KernelRecord), header.kernels_offset + end_kernel_id * sizeof(KernelRecord));
+        auto advise_rows = [&](uint64_t offsets_offset, uint64_t ids_offset)
+        {
+            const uint32_t *offsets = GetSection<uint32_t>(offsets_offset);
+            advise(offsets_offset + first_kernel_id * sizeof(uint32_t), offsets_offset + (end_kernel_id + 1) * sizeof(uint32_t));
+            advise(ids_offset + offsets[first_kernel_id] * sizeof(uint32_t), ids_offset + offsets[end_kernel_id] * sizeof(uint32_t));
+        };
+        advise_rows(header.reason_offsets_offset, header.reasons_offset);
+        advise_rows(header.consequence_offsets_offset, header.consequences_offset);
+        advise_rows(header.participant_offsets_offset, header.participants_offset);
+#endif
+    }
+
+    uint32_t MappedChronicle::FindLastOfActorBeforeTick(size_t tick, size_t actor_id, KernelType type, uint32_t subtype) const
+    {
+        IdRange kernel_ids = GetActorKernels(actor_id);
+        const uint32_t *end = std::lower_bound(kernel_ids.begin(), kernel_ids.end(), tick, [this](uint32_t kernel_id, size_t value)
+                                               { return GetKernel(kernel_id).tick < value; });
+        for (const uint32_t *it = end; it != kernel_ids.begin();)
+        {
+            --it;
+            const KernelRecord &record = GetKernel(*it);
+            if (record.type == static_cast<uint8_t>(type) && record.owner_id == actor_id && (subtype == no_id_ || record.subtype == subtype))
+            {
+                return *it;
+            }
+        }
+        return no_id_;
+    }
+
+    bool MappedChronicle::IsValid() const
+    {
+        if (size_ < sizeof(Header))
+        {
+            return false;
+        }
+        const Header &header = GetHeader();
+        if (std::memcmp(header.magic, magic_, sizeof(magic_)) != 0 || header.version != version_ || header.header_size != sizeof(Header) || header.file_size != size_)
+        {
+            return false;
+        }
+        auto fits = [this](uint64_t offset, uint64_t size)
+        { return offset % 4 == 0 && offset <= size_ && size <= size_ - offset; };
+        auto rows_fit = [&](uint64_t offsets_offset, uint64_t ids_offset, uint64_t row_count)
+        {
+            if (!fits(offsets_offset, (row_count + 1) * sizeof(uint32_t)))
+            {
+                return false;
+            }
+            const uint32_t *offsets = GetSection<uint32_t>(offsets_offset);
+            for (uint64_t row = 0; row < row_count; ++row)
+            {
+                if (offsets[row] > offsets[row + 1])
+                {
+                    return false;
+                }
+            }
+            return fits(ids_offset, static_cast<uint64_t>(offsets[row_count]) * sizeof(uint32_t));
+        };
+        return fits(header.kernels_offset, header.kernel_count * sizeof(KernelRecord)) &&
+               rows_fit(header.reason_offsets_offset, header.reasons_offset, header.kernel_count) &&
+               rows_fit(header.consequence_offsets_offset, header.consequences_offset, header.kernel_count) &&
+               rows_fit(header.participant_offsets_offset, header.participants_offset, header.kernel_count) &&
+               rows_fit(header.actor_kernel_offsets_offset, header.actor_kernels_offset, header.actor_count) &&
+               fits(header.actors_offset, header.actor_count * sizeof(ActorRecord)) &&
+               fits(header.strings_offset, header.strings_size) &&
+               (header.strings_size == 0 || GetSection<char>(header.strings_offset)[header.strings_size - 1] == '\0');
+    }
+} // namespace tattletale
@@ -0,0 +1,430 @@
+#ifndef TALE_GLOBALS_MAPPEDCHRONICLE_H
+#define TALE_GLOBALS_MAPPEDCHRONICLE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "shared/kernels/kernel.hpp"
+#include "shared/kernels/resourcekernels/emotion.hpp"
+
+namespace tattletale
+{
+    class Chronicle;
+    /**
+     * @brief Read-only view of a Chronicle that was saved to a binary file.
+     *
+     * The file is memory mapped and every query reads straight from the mapping, no Kernel objects are ever created.
+     * This allows loading the result of a long simulation in milliseconds and running curation experiments on it without simulating again.
+     *
+     * All numbers are stored in the byte order of the machine that wrote the file and every section starts at a multiple of 8 bytes.
+     * The file consists of a Header followed by these sections:
+     * - One KernelRecord per Kernel, indexed by kernel id.
+     * - Reasons, consequences and participants of each Kernel as compressed sparse rows: kernel count + 1 uint32_t offsets followed by the uint32_t kernel or actor ids.
+     * - The kernel ids of each Actor as compressed sparse rows, sorted by id and therefore by tick.
+     * - One ActorRecord per Actor, indexed by actor id.
+     * - The string table holding every name exactly once, each one terminated by '\0'.
+     */
+    class MappedChronicle
+    {
+    public:
+        /**
+         * @brief Identifies the file format, the first bytes of every file.
+         */
+        static constexpr char magic_[8] = {'T', 'T', 'C', 'H', 'R', 'O', 'N', '\0'};
+        /**
+         * @brief Version of the file format, only files of exactly this version can be opened.
+         */
+        static constexpr uint32_t version_ = 1;
+        /**
+         * @brief Marks a missing id, e.g. the target of a Kernel that is no Relationship.
+         */
+        static constexpr uint32_t no_id_ = UINT32_MAX;
+        /**
+         * @brief How many records Write collects before they are written in one go.
+         */
+        static constexpr size_t record_buffer_size_ = 1 << 12;
+        /**
+         * @brief Fixed size description of one Kernel.
+         */
+        struct KernelRecord
+        {
+            /**
+             * @brief In which tick the Kernel was created.
+             */
+            uint64_t tick;
+            /**
+             * @brief Id of the Actor owning the Kernel.
+             */
+            uint32_t owner_id;
+            /**
+             * @brief Offset of the name of the Kernel in the string table.
+             */
+            uint32_t name;
+            /**
+             * @brief The converted EmotionType, RelationshipType or GoalType, or the prototype id for \link Interaction Interactions \endlink.
+             */
+            uint32_t subtype;
+            /**
+             * @brief Id of the Actor targeted by a Relationship, no_id_ for every other KernelType.
+             */
+            uint32_t target_id;
+            /**
+             * @brief Value of \link Resource Resources \endlink, \link Emotion Emotions \endlink and \link Relationship Relationships \endlink, 0 otherwise.
+             */
+            float value;
+            /**
+             * @brief Chance of the Kernel as returned by Kernel::GetChance.
+             */
+            float chance;
+            /**
+             * @brief The converted KernelType.
+             */
+            uint8_t type;
+            /**
+             * @brief Keeps the size of the record a multiple of 8 bytes.
+             */
+            uint8_t padding[7];
+        };
+        /**
+         * @brief Fixed size description of one Actor.
+         */
+        struct ActorRecord
+        {
+            /**
+             * @brief Offset of the first name in the string table.
+             */
+            uint32_t first_name;
+            /**
+             * @brief Offset of the last name in the string table.
+             */
+            uint32_t last_name;
+        };
+        /**
+         * @brief Start of every file, describing where each section is.
+         */
+        struct Header
+        {
+            /**
+             * @brief Always magic_.
+             */
+            char magic[8];
+            /**
+             * @brief The version_ the file was written with.
+             */
+            uint32_t version;
+            /**
+             * @brief Size of the Header in bytes.
+             */
+            uint32_t header_size;
+            /**
+             * @brief Amount of \link Kernel Kernels \endlink.
+             */
+            uint64_t kernel_count;
+            /**
+             * @brief Amount of \link Actor Actors \endlink.
+             */
+            uint64_t actor_count;
+            /**
+             * @brief Offset of the KernelRecord section.
+             */
+            uint64_t kernels_offset;
+            /**
+             * @brief Offset of the row offsets of the reasons.
+             */
+            uint64_t reason_offsets_offset;
+            /**
+             * @brief Offset of the reason ids.
+             */
+            uint64_t reasons_offset;
+            /**
+             * @brief Offset of the row offsets of the consequences.
+             */
+            uint64_t consequence_offsets_offset;
+            /**
+             * @brief Offset of the consequence ids.
+             */
+            uint64_t consequences_offset;
+            /**
+             * @brief Offset of the row offsets of the participants.
+             */
+            uint64_t participant_offsets_offset;
+            /**
+             * @brief Offset of the participant ids.
+             */
+            uint64_t participants_offset;
+            /**
+             * @brief Offset of the row offsets of the kernels of each Actor.
+             */
+            uint64_t actor_kernel_offsets_offset;
+            /**
+             * @brief Offset of the kernel ids of each Actor.
+             */
+            uint64_t actor_kernels_offset;
+            /**
+             * @brief Offset of the ActorRecord section.
+             */
+            uint64_t actors_offset;
+            /**
+             * @brief Offset of the string table.
+             */
+            uint64_t strings_offset;
+            /**
+             * @brief Size of the string table in bytes.
+             */
+            uint64_t strings_size;
+            /**
+             * @brief Size of the whole file in bytes.
+             */
+            uint64_t file_size;
+        };
+        /**
+         * @brief A range of ids inside the mapping.
+         */
+        struct IdRange
+        {
+            /**
+             * @brief The first id of the range.
+             */
+            const uint32_t *first;
+            /**
+             * @brief One past the last id of the range.
+             */
+            const uint32_t *last;
+            const uint32_t *begin() const { return first; }
+            const uint32_t *end() const { return last; }
+            size_t size() const { return last - first; }
+            uint32_t operator[](size_t index) const { return first[index]; }
+        };
+
+        /**
+         * @brief Writes the current state of a Chronicle to a binary file that can be opened by a MappedChronicle.
+         *
+         * The records are written while Chronicle::ForEachKernel visits the \link Kernel Kernels \endlink, so spilled ones are read back from the spill file
+         * with every block decoded once and the file also covers what happened before the spill horizon. Only the id rows are held in memory, since
+         * the consequences are built by inverting the reasons.
+         *
+         * @param chronicle The Chronicle that will be written.
+         * @param path Path of the file, an existing file gets overwritten.
+         * @return Wether the file could be written.
+         */
+        static bool Write(const Chronicle &chronicle, const std::string &path);
+        /**
+         * @brief Describes a Kernel as a KernelRecord.
+         *
+         * @param kernel The Kernel.
+         * @param name Offset of the name of the Kernel in the string table the record will be stored with.
+         * @return The record.
+         */
+        static KernelRecord CreateKernelRecord(Kernel *kernel, uint32_t name);
+
+        MappedChronicle() = default;
+        MappedChronicle(const MappedChronicle &) = delete;
+        MappedChronicle &operator=(const MappedChronicle &) = delete;
+        /**
+         * @brief Destructor, unmapping the file if one is open.
+         */
+        ~MappedChronicle();
+        /**
+         * @brief Maps a file written by Write, closing the previously opened file.
+         *
+         * @param path Path of the file.
+         * @return Wether the file could be mapped and is a valid chronicle file of the current version.
+         */
+        bool Open(const std::string &path);
+        /**
+         * @brief Unmaps the current file, does nothing if no file is open.
+         */
+        void Close();
+        /**
+         * @brief Checks wether a file is currently mapped.
+         *
+         * @return The result of the check.
+         */
+        bool IsOpen() const;
+        /**
+         * @brief Getter for the amount of \link Kernel Kernels \endlink in the file.
+         *
+         * @return The amount of \link Kernel Kernels \endlink.
+         */
+        size_t GetKernelAmount() const;
+        /**
+         * @brief Getter for the amount of \link Actor Actors \endlink in the file.
+         *
+         * @return The amount of \link Actor Actors \endlink.
+         */
+        size_t GetActorAmount() const;
+        /**
+         * @brief Getter for the record of a Kernel.
+         *
+         * @param kernel_id The id of the Kernel.
+         * @return The record.
+         */
+        const KernelRecord &GetKernel(size_t kernel_id) const;
+        /**
+         * @brief Getter for the KernelType of a Kernel.
+         *
+         * @param kernel_id The id of the Kernel.
+         * @return The KernelType.
+         */
+        KernelType GetKernelType(size_t kernel_id) const;
+        /**
+         * @brief Getter for the name of a Kernel.
+         *
+         * @param kernel_id The id of the Kernel.
+         * @return The name, pointing into the mapping.
+         */
+        const char *GetKernelName(size_t kernel_id) const;
+        /**
+         * @brief Getter for the ids of the reasons of a Kernel.
+         *
+         * @param kernel_id The id of the Kernel.
+         * @return The kernel ids of the reasons.
+         */
+        IdRange GetReasons(size_t kernel_id) const;
+        /**
+         * @brief Getter for the ids of the consequences of a Kernel.
+         *
+         * @param kernel_id The id of the Kernel.
+         * @return The kernel ids of the consequences.
+         */
+        IdRange GetConsequences(size_t kernel_id) const;
+        /**
+         * @brief Getter for the ids of every Actor taking part in a Kernel, starting with its owner.
+         *
+         * @param kernel_id The id of the Kernel.
+         * @return The actor ids.
+         */
+        IdRange GetParticipants(size_t kernel_id) const;
+        /**
+         * @brief Getter for the ids of every Kernel an Actor took part in, sorted by id and tick.
+         *
+         * @param actor_id The id of the Actor.
+         * @return The kernel ids.
+         */
+        IdRange GetActorKernels(size_t actor_id) const;
+        /**
+         * @brief Getter for the full name of an Actor.
+         *
+         * @param actor_id The id of the Actor.
+         * @return The first and last name separated by a space.
+         */
+        std::string GetActorName(size_t actor_id) const;
+        /**
+         * @brief Getter for the tick of the last Kernel.
+         *
+         * @return The tick, 0 if there are no \link Kernel Kernels \endlink.
+         */
+        size_t GetLastTick() const;
+        /**
+         * @brief Finds the last Emotion of one EmotionType an Actor owned before the passed tick, like Chronicle::GetLastEmotionOfType.
+         *
+         * @param tick The tick before which the Emotion must have been created.
+         * @param actor_id The id of the Actor.
+         * @param type The EmotionType.
+         * @return The kernel id of the Emotion, no_id_ if there is none.
+         */
+        uint32_t GetLastEmotionOfType(size_t tick, size_t actor_id, EmotionType type) const;
+        /**
+         * @brief Finds the last wealth Resource of an Actor before the passed tick, like Chronicle::GetLastWealth.
+         *
+         * @param tick The tick before which the Resource must have been created.
+         * @param actor_id The id of the Actor.
+         * @return The kernel id of the Resource, no_id_ if there is none.
+         */
+        uint32_t GetLastWealth(size_t tick, size_t actor_id) const;
+        /**
+         * @brief Asks the system to read the records, reasons, consequences and participants of a range of \link Kernel Kernels \endlink ahead of time.
+         *
+         * Does nothing on Windows, where the mapping is only read on demand.
+         *
+         * @param first_kernel_id The id of the first Kernel of the range.
+         * @param end_kernel_id One past the id of the last Kernel of the range.
+         */
+        void Prefetch(size_t first_kernel_id, size_t end_kernel_id) const;
+        /**
+         * @brief Tells the system that the data of a range of \link Kernel Kernels \endlink is not needed anymore, so its memory can be reused.
+         *
+         * The data stays accessible, it just gets read from the file again when it is used. Only pages that lie completely inside the range are released.
+         * Does nothing on Windows.
+         *
+         * @param first_kernel_id The id of the first Kernel of the range.
+         * @param end_kernel_id One past the id of the last Kernel of the range.
+         */
+        void Release(size_t first_kernel_id, size_t end_kernel_id) const;
+
+    private:
+        /**
+         * @brief Start of the mapping, nullptr if no file is open.
+         */
+        const unsigned char *data_ = nullptr;
+        /**
+         * @brief Size of the mapping in bytes.
+         */
+        size_t size_ = 0;
+#ifdef _WIN32
+        /**
+         * @brief Handle of the opened file.
+         */
+        void *file_handle_ = nullptr;
+        /**
+         * @brief Handle of the file mapping object.
+         */
+        void *mapping_handle_ = nullptr;
+#endif
+        /**
+         * @brief Getter for the header at the start of the mapping.
+         *
+         * @return The header.
+         */
+        const Header &GetHeader() const;
+        /**
+         * @brief Getter for a typed pointer to a section of the mapping.
+         *
+         * @param offset The offset of the section in bytes.
+         * @return Pointer to the start of the section.
+         */
+        template <typename T>
+        const T *GetSection(uint64_t offset) const
+        {
+            return reinterpret_cast<const T *>(data_ + offset);
+        }
+        /**
+         * @brief Getter for one row of a compressed sparse row section.
+         *
+         * @param offsets_offset Offset of the row offsets.
+         * @param ids_offset Offset of the ids.
+         * @param row The row.
+         * @return The ids of the row.
+         */
+        IdRange GetRow(uint64_t offsets_offset, uint64_t ids_offset, size_t row) const;
+        /**
+         * @brief Passes the byte ranges holding the data of a range of \link Kernel Kernels \endlink to the system as paging advice.
+         *
+         * @param first_kernel_id The id of the first Kernel of the range.
+         * @param end_kernel_id One past the id of the last Kernel of the range.
+         * @param will_need Wether the data will be needed soon or can be released.
+         */
+        void AdviseKernels(size_t first_kernel_id, size_t end_kernel_id, bool will_need) const;
+        /**
+         * @brief Finds the last Kernel of an Actor before the passed tick that fulfills a condition.
+         *
+         * Finds the position of the tick with a binary search and walks backwards from there.
+         *
+         * @param tick The tick before which the Kernel must have been created.
+         * @param actor_id The id of the Actor.
+         * @param type The KernelType of the Kernel.
+         * @param subtype The subtype the Kernel must have, no_id_ for any.
+         * @return The kernel id, no_id_ if there is none.
+         */
+        uint32_t FindLastOfActorBeforeTick(size_t tick, size_t actor_id, KernelType type, uint32_t subtype) const;
+        /**
+         * @brief Checks wether the header is valid and every section fits into the mapping.
+         *
+         * The ids and string offsets inside the sections are trusted, so only files written by Write should be opened.
+         *
+         * @return The result of the check.
+         */
+        bool IsValid() const;
+    };
+} // namespace tattletale
+#endif // TALE_GLOBALS_MAPPEDCHRONICLE_H
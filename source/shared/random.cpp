@@ -1,5 +1,6 @@
 #include "shared/random.hpp"
 #include <algorithm>
+#include <limits>
 namespace tattletale
 {
     Random::Random()
@@ -30,27 +31,68 @@ namespace tattletale
         std::uniform_real_distribution<float> distribution(min, max);
         return distribution(rng_);
     }
+    double Random::GetCanonical()
+    {
+        return std::generate_canonical<double, std::numeric_limits<double>::digits>(rng_);
+    }
     size_t Random::PickIndex(const std::vector<float> &probability_distribution, bool support_all_zeroes)
     {
+        std::vector<double> &scratch = pick_scratch_;
+        size_t count = probability_distribution.size();
+        // like std::discrete_distribution, a single index is picked without drawing
+        if (count < 2)
+        {
+            return 0;
+        }
+        bool all_zeros = false;
         if (support_all_zeroes)
         {
-            bool all_zeros = true;
-            for (auto value : probability_distribution)
+            all_zeros = std::all_of(probability_distribution.begin(), probability_distribution.end(), [](float value)
+                                    { return value == 0; });
+        }
+        scratch.resize(count);
+        if (reproducible_picking_)
+        {
+            // same steps as std::discrete_distribution: normalize with the double sum, accumulate, force the last entry to one
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i)
             {
-                if (value != 0)
-                {
-                    all_zeros = false;
-                }
+                sum += (all_zeros ? 1.0 : static_cast<double>(probability_distribution[i]));
             }
-            if (all_zeros)
+            double cumulative = 0.0;
+            for (size_t i = 0; i < count; ++i)
             {
-                std::vector<float> new_probability_distribution(probability_distribution.size(), 1.0f);
-                std::discrete_distribution<size_t> new_distribution(new_probability_distribution.begin(), new_probability_distribution.end());
-                return new_distribution(rng_);
+                double probability = (all_zeros ? 1.0 : static_cast<double>(probability_distribution[i])) / sum;
+                cumulative = (i == 0 ? probability : cumulative + probability);
+                scratch[i] = cumulative;
             }
+            scratch[count - 1] = 1.0;
+            double value = GetCanonical();
+            return std::lower_bound(scratch.begin(), scratch.end(), value) - scratch.begin();
         }
-        std::discrete_distribution<size_t> distribution(probability_distribution.begin(), probability_distribution.end());
-        return distribution(rng_);
+
+        double cumulative = 0.0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            cumulative += (all_zeros ? 1.0 : static_cast<double>(probability_distribution[i]));
+            scratch[i] = cumulative;
+        }
+        if (cumulative <= 0.0)
+        {
+            return 0;
+        }
+        double value = std::generate_canonical<double, std::numeric_limits<uint32_t>::digits>(rng_) * cumulative;
+        // upper bound so indices with a chance of zero can never be picked
+        size_t index = std::min(static_cast<size_t>(std::upper_bound(scratch.begin(), scratch.end(), value) - scratch.begin()), count - 1);
+        while (index > 0 && scratch[index] == scratch[index - 1])
+        {
+            --index;
+        }
+        return index;
+    }
+    void Random::SetReproduciblePicking(bool reproducible)
+    {
+        reproducible_picking_ = reproducible;
     }
 
     void Random::Shuffle(std::vector<uint32_t> &out_vector)
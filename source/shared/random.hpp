@@ -59,6 +59,13 @@ namespace tattletale
          * @return The random float
          */
         float GetFloat(float min, float max);
+        /**
+         * @brief Getter for a random double in the range [0.0, 1.0).
+         *
+         * Uses the full 53 bits of precision of a double, the same way the standard distributions do.
+         * @return The random double.
+         */
+        double GetCanonical();
 
         /**
          * @brief Getter for a random index according to a probability distribution.
@@ -67,11 +74,21 @@ namespace tattletale
          *If all passed values are zero a division through zero happens, because of that we have to check for that case. As this is quite
          * a costly operation though, the user has to turn that check on manually if they know it could happen with the bool parameter.
          * If it is turned on, all zeroes would mean every index has the same chance to be picked.
+         * Uses an internal scratch buffer, so no allocation happens once it has grown to the biggest distribution.
+         * In the reproducible mode (the default) the cumulative probabilities are built exactly like std::discrete_distribution builds them
+         * and the same random number is drawn, so the picked index is the same as before for every seed. Without it the prefix sums are built
+         * in a single pass without normalizing and only one number is drawn from the engine.
          * @param probability_distribution The vector in which the chances for each index are stored.
          * @param support_all_zeroes Flag wether the function has to check if every chance is zero.
          * @return The random index
          */
         size_t PickIndex(const std::vector<float> &probability_distribution, bool support_all_zeroes = false);
+        /**
+         * @brief Sets wether PickIndex reproduces the picks of std::discrete_distribution.
+         *
+         * @param reproducible The new value.
+         */
+        void SetReproduciblePicking(bool reproducible);
         /**
          * @brief Shuffles the elements of the passed vector.
          *
@@ -84,6 +101,14 @@ namespace tattletale
          * @brief Random number generator engine. Using Mersenne Twister.
          */
         std::mt19937 rng_;
+        /**
+         * @brief Wether PickIndex reproduces the picks of std::discrete_distribution.
+         */
+        bool reproducible_picking_ = true;
+        /**
+         * @brief Scratch buffer for the prefix sums of PickIndex.
+         */
+        std::vector<double> pick_scratch_;
     };
 } // namespace tattletale
 #endif // TALE_GLOBALS_RANDOM_H
\ No newline at end of file
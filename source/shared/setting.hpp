@@ -4,6 +4,7 @@
 #include <math.h>
 #include <assert.h>
 #include <algorithm>
+#include <string>
 #include <shared/tattletalecore.hpp>
 #include <fmt/core.h>
 #include <fmt/format.h>
@@ -56,6 +57,21 @@ namespace tattletale
          * @brief How many Kernel objects are contained in a chain that could potentially be curated.
          */
         size_t max_chain_size = 5;
+        /**
+         * @brief How many ticks the Chronicle keeps every Kernel in memory before spilling it to disk, 0 keeps everything in memory.
+         *
+         * Queries into the past only see what is still in memory. Chronicle::FindMostOccuringInteractionPrototypeForActorBeforeTick
+         * returns nullptr for ticks before the horizon, since the counts behind it are only kept as a whole.
+         */
+        size_t spill_tick_horizon = 0;
+        /**
+         * @brief Path of the file spilled \link Kernel Kernels \endlink are written to.
+         */
+        std::string spill_path = "chronicle_spill.bin";
+        /**
+         * @brief The most verbose LogLevel that gets printed. Applied through SetLogLevel before the simulation starts.
+         */
+        LogLevel log_level = LogLevel::kVerbose;
         /**
          * @brief Calculates how many slots are there in total in a week.
          *
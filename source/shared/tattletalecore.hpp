@@ -1,25 +1,96 @@
+#ifndef TALE_TATTLETALECORE_H
+#define TALE_TATTLETALECORE_H
+
 #include "rang.hpp"
+#include <string>
+
+namespace tattletale
+{
+    /**
+     * @brief Levels of the log output, ordered from least to most verbose.
+     *
+     * Each print macro only exists if its output flag is compiled in, on top of that it only prints if its level is enabled at runtime.
+     * The message of a macro is only evaluated when it actually gets printed, so a disabled level costs a single branch.
+     */
+    enum class LogLevel
+    {
+        kNone,
+        kProgress,
+        kDebug,
+        kVerbose,
+        kLast
+    };
+    /**
+     * @brief Holds the most verbose LogLevel that currently gets printed.
+     *
+     * @return Reference to the current LogLevel.
+     */
+    inline LogLevel &GetLogLevelStorage()
+    {
+        static LogLevel log_level = LogLevel::kVerbose;
+        return log_level;
+    }
+    /**
+     * @brief Sets the most verbose LogLevel that gets printed. Defaults to LogLevel::kVerbose, so everything that is compiled in gets printed.
+     *
+     * @param log_level The new LogLevel.
+     */
+    inline void SetLogLevel(LogLevel log_level)
+    {
+        GetLogLevelStorage() = log_level;
+    }
+    /**
+     * @brief Checks wether messages of the passed LogLevel get printed.
+     *
+     * @param log_level The LogLevel of the message.
+     * @return The result of the check.
+     */
+    inline bool IsLogLevelEnabled(LogLevel log_level)
+    {
+        return log_level != LogLevel::kNone && log_level <= GetLogLevelStorage();
+    }
+    /**
+     * @brief Converts the name of a LogLevel, like it is passed on the command line, into the LogLevel.
+     *
+     * @param string One of "none", "progress", "debug" or "verbose".
+     * @return The LogLevel, LogLevel::kLast if the name is unknown.
+     */
+    inline LogLevel StringToLogLevel(const std::string &string)
+    {
+        const std::string names[] = {"none", "progress", "debug", "verbose"};
+        for (int level_index = 0; level_index < static_cast<int>(LogLevel::kLast); ++level_index)
+        {
+            if (string == names[level_index])
+            {
+                return static_cast<LogLevel>(level_index);
+            }
+        }
+        return LogLevel::kLast;
+    }
+} // namespace tattletale
 
 #ifdef TATTLETALE_PROGRESS_PRINT_OUTPUT
-#define TATTLETALE_PROGRESS_PRINT(x) std::cout << rang::style::reset << rang::bg::reset << rang::fg::green  << x << rang::fg::reset << "\r"; std::cout.flush()
+#define TATTLETALE_PROGRESS_PRINT(x) if (tattletale::IsLogLevelEnabled(tattletale::LogLevel::kProgress)) { std::cout << rang::style::reset << rang::bg::reset << rang::fg::green  << x << rang::fg::reset << "\r"; std::cout.flush(); } else {}
 
 #else
 #define TATTLETALE_PROGRESS_PRINT(x)
 #endif
 
 #ifdef TATTLETALE_DEBUG_PRINT_OUTPUT
-#define TATTLETALE_DEBUG_PRINT(x) std::cout << rang::bg::gray << rang::fg::blue << rang::style::bold << "[ DEBUG ][" << __TIME__ << "]" \
-                                            << rang::style::reset << rang::bg::reset << rang::fg::reset << "\n"                         \
-                                            << x << "\n\n"
+#define TATTLETALE_DEBUG_PRINT(x) if (tattletale::IsLogLevelEnabled(tattletale::LogLevel::kDebug)) {                                 \
+                                      std::cout << rang::bg::gray << rang::fg::blue << rang::style::bold << "[ DEBUG ][" << __TIME__ << "]" \
+                                                << rang::style::reset << rang::bg::reset << rang::fg::reset << "\n"                         \
+                                                << x << "\n\n"; } else {}
 
 #else
 #define TATTLETALE_DEBUG_PRINT(x)
 #endif
 
 #ifdef TATTLETALE_VERBOSE_PRINT_OUTPUT
-#define TATTLETALE_VERBOSE_PRINT(x) std::cout << rang::bg::yellow << rang::fg::reset << rang::style::bold << "[VERBOSE][" << __TIME__ << "]" \
-                                              << rang::style::reset << rang::bg::reset << rang::fg::reset << "\n"                            \
-                                              << x << "\n\n"
+#define TATTLETALE_VERBOSE_PRINT(x) if (tattletale::IsLogLevelEnabled(tattletale::LogLevel::kVerbose)) {                                   \
+                                        std::cout << rang::bg::yellow << rang::fg::reset << rang::style::bold << "[VERBOSE][" << __TIME__ << "]" \
+                                                  << rang::style::reset << rang::bg::reset << rang::fg::reset << "\n"                            \
+                                                  << x << "\n\n"; } else {}
 #else
 #define TATTLETALE_VERBOSE_PRINT(x)
 #endif
@@ -29,3 +100,4 @@
 #else
 #define TATTLETALE_ERROR_PRINT(value, message)
 #endif
+#endif // TALE_TATTLETALECORE_H
@@ -0,0 +1,19 @@
+#include "tale/actorstatestore.hpp"
+
+namespace tattletale
+{
+    void ActorStateStore::AddActor(size_t actor_id)
+    {
+        if (actor_id < wealth_.size())
+        {
+            return;
+        }
+        size_t actor_count = actor_id + 1;
+        wealth_.resize(actor_count, 0.0f);
+        for (auto &emotion : emotions_)
+        {
+            emotion.resize(actor_count, 0.0f);
+        }
+        goal_types_.resize(actor_count, GoalType::kLast);
+    }
+} // namespace tattletale
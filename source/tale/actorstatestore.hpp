@@ -0,0 +1,136 @@
+#ifndef TALE_ACTORSTATESTORE_H
+#define TALE_ACTORSTATESTORE_H
+
+#include <vector>
+#include <array>
+#include "shared/kernels/goal.hpp"
+#include "shared/kernels/resourcekernels/emotion.hpp"
+
+namespace tattletale
+{
+    /**
+     * @brief Stores the current numeric state of every Actor in dense per-field arrays.
+     *
+     * The \link Kernel Kernels \endlink an Actor holds are only kept for provenance. Every hot read during the simulation
+     * (chance calculations and requirement checks) goes through this store instead, so the values of all \link Actor Actors \endlink
+     * for one field lie next to each other in memory. Each array is indexed by the id of the Actor.
+     */
+    class ActorStateStore
+    {
+    public:
+        /**
+         * @brief Makes room for the Actor with the passed id.
+         *
+         * Grows every array so the passed id is a valid index. New entries are zero initialized and have no Goal.
+         *
+         * @param actor_id The id of the Actor that is being added.
+         */
+        void AddActor(size_t actor_id);
+        /**
+         * @brief Getter for the amount of \link Actor Actors \endlink the store has room for.
+         *
+         * @return The amount of \link Actor Actors \endlink.
+         */
+        size_t GetActorCount() const
+        {
+            return wealth_.size();
+        }
+        /**
+         * @brief Getter for the current wealth of an Actor.
+         *
+         * @param actor_id The id of the Actor.
+         * @return The wealth value between -1.0 and 1.0.
+         */
+        float GetWealth(size_t actor_id) const
+        {
+            return wealth_[actor_id];
+        }
+        /**
+         * @brief Setter for the current wealth of an Actor.
+         *
+         * @param actor_id The id of the Actor.
+         * @param value The new wealth value between -1.0 and 1.0.
+         */
+        void SetWealth(size_t actor_id, float value)
+        {
+            wealth_[actor_id] = value;
+        }
+        /**
+         * @brief Getter for the current value of one Emotion of an Actor.
+         *
+         * @param actor_id The id of the Actor.
+         * @param type_index The index of the EmotionType.
+         * @return The Emotion value between -1.0 and 1.0.
+         */
+        float GetEmotion(size_t actor_id, int type_index) const
+        {
+            return emotions_[type_index][actor_id];
+        }
+        /**
+         * @brief Setter for the current value of one Emotion of an Actor.
+         *
+         * @param actor_id The id of the Actor.
+         * @param type_index The index of the EmotionType.
+         * @param value The new Emotion value between -1.0 and 1.0.
+         */
+        void SetEmotion(size_t actor_id, int type_index, float value)
+        {
+            emotions_[type_index][actor_id] = value;
+        }
+        /**
+         * @brief Getter for the GoalType of an Actor.
+         *
+         * @param actor_id The id of the Actor.
+         * @return The GoalType, GoalType::kLast if the Actor has no Goal yet.
+         */
+        GoalType GetGoalType(size_t actor_id) const
+        {
+            return goal_types_[actor_id];
+        }
+        /**
+         * @brief Setter for the GoalType of an Actor.
+         *
+         * @param actor_id The id of the Actor.
+         * @param type The new GoalType.
+         */
+        void SetGoalType(size_t actor_id, GoalType type)
+        {
+            goal_types_[actor_id] = type;
+        }
+        /**
+         * @brief Getter for the dense wealth array of all \link Actor Actors \endlink.
+         *
+         * @return Pointer to the first element, indexed by Actor id.
+         */
+        const float *GetWealthArray() const
+        {
+            return wealth_.data();
+        }
+        /**
+         * @brief Getter for the dense array of one EmotionType of all \link Actor Actors \endlink.
+         *
+         * @param type_index The index of the EmotionType.
+         * @return Pointer to the first element, indexed by Actor id.
+         */
+        const float *GetEmotionArray(int type_index) const
+        {
+            return emotions_[type_index].data();
+        }
+
+    private:
+        /**
+         * @brief The wealth value of each Actor.
+         */
+        std::vector<float> wealth_;
+        /**
+         * @brief One array per EmotionType holding the value of that Emotion for each Actor.
+         */
+        std::array<std::vector<float>, static_cast<size_t>(EmotionType::kLast)> emotions_;
+        /**
+         * @brief The GoalType of each Actor.
+         */
+        std::vector<GoalType> goal_types_;
+    };
+
+} // namespace tattletale
+#endif // TALE_ACTORSTATESTORE_H
@@ -7,6 +7,8 @@
 #include <iostream>
 #include <assert.h>
 #include <fstream>
+#include <algorithm>
+#include <limits>
 
 namespace tattletale
 {
@@ -48,6 +50,10 @@ namespace tattletale
 
             ++interaction_id;
         }
+        BuildTendencyMatrix();
+        BuildCandidateBuckets();
+        BuildEmotionRequirementBounds();
+        BuildGoalEffects();
     }
     uint32_t InteractionStore::GetRandomInteractionPrototypeIndex() const
     {
@@ -64,18 +70,22 @@ namespace tattletale
         TATTLETALE_ERROR_PRINT(prototype_index < requirements_catalogue_.size(), fmt::format("Requirement with id {} does not exist", prototype_index));
         return requirements_catalogue_.at(prototype_index)->participant_count;
     }
-    const std::vector<float> &InteractionStore::GetWealthEffects(size_t prototype_index) const
+    size_t InteractionStore::GetMaxParticipantCount() const
+    {
+        return participant_counts_.empty() ? 0 : participant_counts_.back();
+    }
+    const std::vector<InteractionPrototype::EffectBlock> &InteractionStore::GetWealthEffects(size_t prototype_index) const
     {
         TATTLETALE_ERROR_PRINT(prototype_index < prototype_catalogue_.size(), fmt::format("Prototype with id {} does not exist", prototype_index));
         return prototype_catalogue_.at(prototype_index)->wealth_effects;
     }
 
-    const std::vector<std::vector<float>> &InteractionStore::GetEmotionEffects(size_t prototype_index) const
+    const std::vector<InteractionPrototype::EffectBlock> &InteractionStore::GetEmotionEffects(size_t prototype_index) const
     {
         TATTLETALE_ERROR_PRINT(prototype_index < prototype_catalogue_.size(), fmt::format("Prototype with id {} does not exist", prototype_index));
         return prototype_catalogue_.at(prototype_index)->emotion_effects;
     }
-    const std::vector<robin_hood::unordered_map<size_t, std::vector<float>>> &InteractionStore::GetRelationshipEffects(size_t prototype_index) const
+    const std::vector<InteractionPrototype::EffectBlock> &InteractionStore::GetRelationshipEffects(size_t prototype_index) const
     {
         TATTLETALE_ERROR_PRINT(prototype_index < prototype_catalogue_.size(), fmt::format("Prototype with id {} does not exist", prototype_index));
         return prototype_catalogue_.at(prototype_index)->relationship_effects;
@@ -83,10 +93,10 @@ namespace tattletale
     Interaction *InteractionStore::CreateInteraction(Chronicle &chronicle, size_t prototype_index, float chance, size_t tick, std::vector<Kernel *> reasons, std::vector<Actor *> participants)
     {
         TATTLETALE_ERROR_PRINT(prototype_index < prototype_catalogue_.size(), fmt::format("Prototype with id {} does not exist", prototype_index));
-        std::shared_ptr<InteractionPrototype> prototype = prototype_catalogue_.at(prototype_index);
-        std::shared_ptr<InteractionRequirement> &requirement = requirements_catalogue_.at(prototype_index);
-        std::shared_ptr<InteractionTendency> &tendency = tendencies_catalogue_.at(prototype_index);
-        return chronicle.CreateInteraction(prototype, requirement, tendency, chance, tick, reasons, participants);
+        const std::shared_ptr<InteractionPrototype> &prototype = prototype_catalogue_.at(prototype_index);
+        const std::shared_ptr<InteractionRequirement> &requirement = requirements_catalogue_.at(prototype_index);
+        const std::shared_ptr<InteractionTendency> &tendency = tendencies_catalogue_.at(prototype_index);
+        return chronicle.CreateInteraction(prototype, requirement, tendency, chance, tick, std::move(reasons), std::move(participants));
     }
     const std::vector<std::shared_ptr<InteractionRequirement>> &InteractionStore::GetRequirementCatalogue() const
     {
@@ -101,6 +111,247 @@ namespace tattletale
         return prototype_catalogue_;
     }
 
+    void InteractionStore::CalculateTendencyChances(const std::array<float, tendency_feature_count_> &features, std::vector<float> &out_chances) const
+    {
+        constexpr size_t block_size = sizeof(TendencyBlock::values) / sizeof(float);
+        out_chances.assign(tendency_block_count_ * block_size, 0.0f);
+        float *chances = out_chances.data();
+        // same summation order as Actor::CalculateInteractionChance so the results are bit identical
+        for (size_t feature_index = 0; feature_index < tendency_feature_count_; ++feature_index)
+        {
+            const float feature = features[feature_index];
+            const TendencyBlock *row = &tendency_matrix_[feature_index * tendency_block_count_];
+            for (size_t block_index = 0; block_index < tendency_block_count_; ++block_index)
+            {
+                float *block_chances = chances + block_index * block_size;
+                for (size_t lane = 0; lane < block_size; ++lane)
+                {
+                    block_chances[lane] += row[block_index].values[lane] * feature;
+                }
+            }
+        }
+        const float chance_parts = static_cast<float>(tendency_feature_count_);
+        const float chance_divisor = static_cast<float>(tendency_feature_count_ * 2);
+        for (size_t i = 0; i < out_chances.size(); ++i)
+        {
+            chances[i] += chance_parts;
+            chances[i] /= chance_divisor;
+        }
+    }
+    InteractionStore::CandidateRange InteractionStore::GetCandidateIndices(ContextType context, GoalType goal_type, size_t group_size, size_t day) const
+    {
+        // the last level that is still within the limit, none if even the first level is above it
+        size_t day_level = std::upper_bound(unlock_days_.begin(), unlock_days_.end(), day) - unlock_days_.begin();
+        size_t count_level = std::upper_bound(participant_counts_.begin(), participant_counts_.end(), group_size) - participant_counts_.begin();
+        if (day_level == 0 || count_level == 0)
+        {
+            return {nullptr, nullptr};
+        }
+        const CandidateBucket &bucket = candidate_buckets_[GetCandidateBucketIndex(static_cast<size_t>(context), static_cast<size_t>(goal_type), count_level - 1)];
+        return {bucket.indices.data(), bucket.indices.data() + bucket.day_level_ends[day_level - 1]};
+    }
+    void InteractionStore::BuildCandidateBuckets()
+    {
+        unlock_days_.clear();
+        participant_counts_.clear();
+        for (auto &requirement : requirements_catalogue_)
+        {
+            unlock_days_.push_back(requirement->day);
+            participant_counts_.push_back(requirement->participant_count);
+        }
+        std::sort(unlock_days_.begin(), unlock_days_.end());
+        unlock_days_.erase(std::unique(unlock_days_.begin(), unlock_days_.end()), unlock_days_.end());
+        std::sort(participant_counts_.begin(), participant_counts_.end());
+        participant_counts_.erase(std::unique(participant_counts_.begin(), participant_counts_.end()), participant_counts_.end());
+
+        // the catalogue sorted by unlock day once, so every bucket keeps that order by just filtering it
+        std::vector<size_t> indices_by_day(requirements_catalogue_.size());
+        for (size_t i = 0; i < indices_by_day.size(); ++i)
+        {
+            indices_by_day[i] = i;
+        }
+        std::stable_sort(indices_by_day.begin(), indices_by_day.end(), [this](size_t first, size_t second)
+                         { return requirements_catalogue_[first]->day < requirements_catalogue_[second]->day; });
+
+        size_t context_count = static_cast<size_t>(ContextType::kLast) + 1;
+        size_t goal_count = static_cast<size_t>(GoalType::kLast) + 1;
+        candidate_buckets_ = std::vector<CandidateBucket>(context_count * goal_count * participant_counts_.size());
+        for (size_t context_index = 0; context_index < context_count; ++context_index)
+        {
+            ContextType context = static_cast<ContextType>(context_index);
+            for (size_t goal_index = 0; goal_index < goal_count; ++goal_index)
+            {
+                GoalType goal_type = static_cast<GoalType>(goal_index);
+                for (size_t count_level = 0; count_level < participant_counts_.size(); ++count_level)
+                {
+                    CandidateBucket &bucket = candidate_buckets_[GetCandidateBucketIndex(context_index, goal_index, count_level)];
+                    for (auto i : indices_by_day)
+                    {
+                        const InteractionRequirement &requirement = *requirements_catalogue_[i];
+                        if ((requirement.context == ContextType::kLast || requirement.context == context) &&
+                            (requirement.goal_type == GoalType::kLast || requirement.goal_type == goal_type) &&
+                            requirement.participant_count <= participant_counts_[count_level])
+                        {
+                            bucket.indices.push_back(i);
+                        }
+                    }
+                    size_t end = 0;
+                    for (auto unlock_day : unlock_days_)
+                    {
+                        while (end < bucket.indices.size() && requirements_catalogue_[bucket.indices[end]]->day <= unlock_day)
+                        {
+                            ++end;
+                        }
+                        bucket.day_level_ends.push_back(end);
+                    }
+                }
+            }
+        }
+    }
+    size_t InteractionStore::GetCandidateBucketIndex(size_t context_index, size_t goal_index, size_t count_level) const
+    {
+        size_t goal_count = static_cast<size_t>(GoalType::kLast) + 1;
+        return (context_index * goal_count + goal_index) * participant_counts_.size() + count_level;
+    }
+    void InteractionStore::CalculateEmotionRequirementMask(const EmotionValues &emotions, std::vector<uint64_t> &out_mask) const
+    {
+        constexpr size_t word_size = 64;
+        size_t padded_count = emotion_minimums_.size() / emotions.size();
+        out_mask.resize(padded_count / word_size);
+        for (size_t word_index = 0; word_index < out_mask.size(); ++word_index)
+        {
+            bool allowed[word_size];
+            for (size_t lane = 0; lane < word_size; ++lane)
+            {
+                allowed[lane] = true;
+            }
+            for (size_t type_index = 0; type_index < emotions.size(); ++type_index)
+            {
+                const float value = emotions[type_index];
+                const float *minimums = &emotion_minimums_[type_index * padded_count + word_index * word_size];
+                const float *maximums = &emotion_maximums_[type_index * padded_count + word_index * word_size];
+                for (size_t lane = 0; lane < word_size; ++lane)
+                {
+                    allowed[lane] &= (value >= minimums[lane]) & (value <= maximums[lane]);
+                }
+            }
+            uint64_t word = 0;
+            for (size_t lane = 0; lane < word_size; ++lane)
+            {
+                word |= static_cast<uint64_t>(allowed[lane]) << lane;
+            }
+            out_mask[word_index] = word;
+        }
+    }
+    void InteractionStore::BuildEmotionRequirementBounds()
+    {
+        constexpr size_t word_size = 64;
+        size_t type_count = static_cast<size_t>(EmotionType::kLast);
+        size_t padded_count = (requirements_catalogue_.size() + word_size - 1) / word_size * word_size;
+        emotion_minimums_ = std::vector<float>(type_count * padded_count, -std::numeric_limits<float>::infinity());
+        emotion_maximums_ = std::vector<float>(type_count * padded_count, std::numeric_limits<float>::infinity());
+        for (size_t i = 0; i < requirements_catalogue_.size(); ++i)
+        {
+            for (size_t type_index = 0; type_index < type_count; ++type_index)
+            {
+                // a negative threshold is an upper bound, a positive one a lower bound and zero means no requirement
+                float value = requirements_catalogue_[i]->emotions[0][type_index];
+                if (value < 0)
+                {
+                    emotion_maximums_[type_index * padded_count + i] = value;
+                }
+                else if (value > 0)
+                {
+                    emotion_minimums_[type_index * padded_count + i] = value;
+                }
+            }
+        }
+    }
+    float InteractionStore::GetGoalEffect(GoalType goal_type, size_t prototype_index) const
+    {
+        return goal_effects_[static_cast<size_t>(goal_type) * prototype_catalogue_.size() + prototype_index];
+    }
+    void InteractionStore::BuildGoalEffects()
+    {
+        size_t catalogue_size = prototype_catalogue_.size();
+        goal_effects_ = std::vector<float>((static_cast<size_t>(GoalType::kLast) + 1) * catalogue_size, 0.0f);
+        for (size_t goal_index = 0; goal_index < static_cast<size_t>(GoalType::kLast); ++goal_index)
+        {
+            for (size_t interaction_index = 0; interaction_index < catalogue_size; ++interaction_index)
+            {
+                const InteractionPrototype &prototype = *prototype_catalogue_[interaction_index];
+                float relevant_effect = 0;
+                switch (static_cast<GoalType>(goal_index))
+                {
+                case GoalType::kWealth:
+                    relevant_effect = prototype.GetWealthEffect(0);
+                    break;
+                case GoalType::kAcceptance:
+                    // skip first as we want the values of other people to this actor
+                    for (size_t i = 1; i < prototype.participant_count; ++i)
+                    {
+                        relevant_effect += prototype.GetRelationshipEffect(i, 0)[static_cast<int>(RelationshipType::kFriendship)];
+                    }
+                    break;
+                case GoalType::kRelationship:
+                    // skip first as we want the values of other people to this actor
+                    for (size_t i = 1; i < prototype.participant_count; ++i)
+                    {
+                        // do both sides of the relationship change
+                        if (prototype.HasRelationshipEffect(i, 0) && prototype.HasRelationshipEffect(0, i))
+                        {
+                            relevant_effect += prototype.GetRelationshipEffect(i, 0)[static_cast<int>(RelationshipType::kLove)];
+                            relevant_effect += prototype.GetRelationshipEffect(0, 1)[static_cast<int>(RelationshipType::kLove)];
+                        }
+                    }
+                    break;
+                case GoalType::kHedonism:
+                    relevant_effect = prototype.GetEmotionEffects(0)[static_cast<int>(EmotionType::kSatisfied)];
+                    break;
+                case GoalType::kPower:
+                {
+                    // undefined effects are zero, so they can be summed up as well
+                    for (size_t i = 0; i < prototype.participant_count; ++i)
+                    {
+                        // using minus here because the actor wants a negative value
+                        relevant_effect -= prototype.GetRelationshipEffect(0, i)[static_cast<int>(RelationshipType::kProtective)];
+                    }
+                    size_t effect_count = prototype.GetRelationshipEffectCount(0);
+                    if (effect_count > 0)
+                    {
+                        relevant_effect /= effect_count;
+                    }
+                    break;
+                }
+                case GoalType::kLast:
+                    break;
+                }
+                goal_effects_[goal_index * catalogue_size + interaction_index] = std::clamp(relevant_effect, -1.0f, 1.0f);
+            }
+        }
+    }
+    void InteractionStore::BuildTendencyMatrix()
+    {
+        constexpr size_t block_size = sizeof(TendencyBlock::values) / sizeof(float);
+        tendency_block_count_ = (tendencies_catalogue_.size() + block_size - 1) / block_size;
+        tendency_matrix_ = std::vector<TendencyBlock>(tendency_feature_count_ * tendency_block_count_);
+        size_t context_count = static_cast<size_t>(ContextType::kLast);
+        for (size_t interaction_index = 0; interaction_index < tendencies_catalogue_.size(); ++interaction_index)
+        {
+            const InteractionTendency &tendency = *tendencies_catalogue_[interaction_index];
+            size_t block_index = interaction_index / block_size;
+            size_t lane = interaction_index % block_size;
+            for (size_t type_index = 0; type_index < context_count; ++type_index)
+            {
+                tendency_matrix_[type_index * tendency_block_count_ + block_index].values[lane] = tendency.contexts[type_index];
+            }
+            tendency_matrix_[context_count * tendency_block_count_ + block_index].values[lane] = tendency.wealth;
+            for (size_t type_index = 0; type_index < static_cast<size_t>(EmotionType::kLast); ++type_index)
+            {
+                tendency_matrix_[(context_count + 1 + type_index) * tendency_block_count_ + block_index].values[lane] = tendency.emotions[type_index];
+            }
+        }
+    }
     bool InteractionStore::ReadPrototypeJSON(nlohmann::json json, size_t participant_count, std::string error_preamble, std::shared_ptr<InteractionPrototype> &out_prototype)
     {
         TATTLETALE_VERBOSE_PRINT("CREATING PROTOTYPE...");
@@ -162,6 +413,7 @@ namespace tattletale
             return false;
         }
 
+        out_prototype->SetParticipantCount(participant_count);
         for (size_t i = 0; i < participant_count; ++i)
         {
             float wealth_value = 0.0f;
@@ -173,14 +425,13 @@ namespace tattletale
             {
                 return false;
             }
-            out_prototype->wealth_effects.push_back(wealth_value);
+            out_prototype->SetWealthEffect(i, wealth_value);
 
             nlohmann::json emotion_map;
             if (!ReadJsonValueFromArray<nlohmann::json, nlohmann::detail::value_t::object>(emotion_map, emotion_json, i, false, error_preamble))
             {
                 return false;
             }
-            out_prototype->emotion_effects.push_back(std::vector<float>(static_cast<int>(EmotionType::kLast)));
             for (auto &key : emotion_type_keys_)
             {
                 float emotion_value = 0.0f;
@@ -192,7 +443,7 @@ namespace tattletale
                 {
                     return false;
                 }
-                out_prototype->emotion_effects[i][static_cast<int>(Emotion::StringToEmotionType(key))] = emotion_value;
+                out_prototype->SetEmotionEffect(i, static_cast<int>(Emotion::StringToEmotionType(key)), emotion_value);
             }
 
             nlohmann::json relationship_changes_array;
@@ -201,7 +452,6 @@ namespace tattletale
                 return false;
             }
             size_t index = 0;
-            out_prototype->relationship_effects.push_back({});
             for (size_t other_participant = 0; other_participant < participant_count; ++other_participant)
             {
                 if (other_participant != i)
@@ -226,7 +476,7 @@ namespace tattletale
                     {
                         return false;
                     }
-                    std::vector<float> vector(static_cast<int>(RelationshipType::kLast));
+                    RelationshipValues vector = {};
                     for (auto &key : relationship_type_keys_)
                     {
                         float value = 0.0f;
@@ -241,7 +491,11 @@ namespace tattletale
                         vector[static_cast<int>(Relationship::StringToRelationshipType(key))] = value;
                     }
 
-                    out_prototype->relationship_effects[i].insert({participant, vector});
+                    // the first effect defined for a pair of participants wins
+                    if (!out_prototype->HasRelationshipEffect(i, participant))
+                    {
+                        out_prototype->SetRelationshipEffect(i, participant, vector);
+                    }
                     ++index;
                 }
             }
@@ -407,7 +661,7 @@ namespace tattletale
             {
                 return false;
             }
-            std::vector<float> relationship_vector(static_cast<int>(RelationshipType::kLast), 0.0f);
+            RelationshipValues relationship_vector = {};
             for (auto &key : relationship_type_keys_)
             {
                 float relationship_value = 0.0f;
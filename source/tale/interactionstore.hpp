@@ -3,6 +3,7 @@
 
 #include <string>
 #include <memory>
+#include <array>
 #include "shared/kernels/interactions/interaction.hpp"
 #include "shared/kernels/interactions/interactionprototype.hpp"
 #include "shared/kernels/interactions/interactionrequirement.hpp"
@@ -26,6 +27,23 @@ namespace tattletale
     class InteractionStore
     {
     public:
+        /**
+         * @brief A range of catalogue indices returned by GetCandidateIndices.
+         */
+        struct CandidateRange
+        {
+            /**
+             * @brief The first index of the range.
+             */
+            const size_t *first;
+            /**
+             * @brief One past the last index of the range.
+             */
+            const size_t *last;
+            const size_t *begin() const { return first; }
+            const size_t *end() const { return last; }
+            size_t size() const { return last - first; }
+        };
         /**
          * @brief Default constructor populates catalogue.
          *
@@ -57,30 +75,36 @@ namespace tattletale
          * @return The participation count
          */
         const size_t &GetParticipantCount(size_t prototype_index) const;
+        /**
+         * @brief Returns the highest participation count of the catalogue.
+         *
+         * @return The participation count, 0 if the catalogue is empty.
+         */
+        size_t GetMaxParticipantCount() const;
         /**
          * @brief Returns the wealth effects for a catalogued InteractionPrototype.
          *
          * Should only really be needed for testing purposes
          * @param prototype_index Index of the queried InteractionPrototype.
-         * @return The wealth effects
+         * @return The wealth effects, laid out like InteractionPrototype::wealth_effects
          */
-        const std::vector<float> &GetWealthEffects(size_t prototype_index) const;
+        const std::vector<InteractionPrototype::EffectBlock> &GetWealthEffects(size_t prototype_index) const;
         /**
          * @brief Returns the emotion effects for a catalogued InteractionPrototype.
          *
          * Should only really be needed for testing purposes
          * @param prototype_index Index of the queried InteractionPrototype.
-         * @return The emotion effects
+         * @return The emotion effects, laid out like InteractionPrototype::emotion_effects
          */
-        const std::vector<std::vector<float>> &GetEmotionEffects(size_t prototype_index) const;
+        const std::vector<InteractionPrototype::EffectBlock> &GetEmotionEffects(size_t prototype_index) const;
         /**
          * @brief Returns the relationship effects for a catalogued InteractionPrototype.
          *
          * Should only really be needed for testing purposes
          * @param prototype_index Index of the queried InteractionPrototype.
-         * @return The relationship effects
+         * @return The relationship effects, laid out like InteractionPrototype::relationship_effects
          */
-        const std::vector<robin_hood::unordered_map<size_t, std::vector<float>>> &GetRelationshipEffects(size_t prototype_index) const;
+        const std::vector<InteractionPrototype::EffectBlock> &GetRelationshipEffects(size_t prototype_index) const;
         /**
          * @brief Creates an interaction from a catalogued InteractionPrototype.
          *
@@ -111,8 +135,63 @@ namespace tattletale
          * @return A Reference to the catalogue for the \link InteractionPrototype Prototypes \endlink.
          */
         const std::vector<std::shared_ptr<InteractionPrototype>> &GetPrototypeCatalogue() const;
+        /**
+         * @brief How many values of an Actor are used to score an InteractionTendency: one per ContextType, wealth and one per EmotionType.
+         */
+        static constexpr size_t tendency_feature_count_ = static_cast<size_t>(ContextType::kLast) + 1 + static_cast<size_t>(EmotionType::kLast);
+        /**
+         * @brief Calculates the tendency chance of every Interaction in the catalogue at once.
+         *
+         * Walks the packed tendency matrix one feature row at a time, so the inner loop runs over consecutive \link Interaction Interactions \endlink
+         * and can be vectorized. Each chance is identical to the one Actor::CalculateInteractionChance returns for the same InteractionTendency.
+         *
+         * @param [in] features The values of the Actor in the order of the matrix rows: 1.0 for the current ContextType and -1.0 for every other one, then wealth, then each EmotionType.
+         * @param [out] out_chances Holds the chance of each Interaction, indexed like the catalogue. Gets resized to the catalogue size rounded up to full blocks.
+         */
+        void CalculateTendencyChances(const std::array<float, tendency_feature_count_> &features, std::vector<float> &out_chances) const;
+        /**
+         * @brief Returns the indices of all \link Interaction Interactions \endlink whose context, goal type, participant count and day requirements are met.
+         *
+         * The lists are built when the catalogue is loaded, one for every combination of ContextType, GoalType and distinct participant count,
+         * each sorted by unlock day. The candidates of a day are a prefix of that list, so this is only a few binary searches.
+         * Emotion and relationship requirements still have to be checked on the returned indices.
+         *
+         * @param context The ContextType the Interaction would take place in.
+         * @param goal_type The GoalType of the Actor that wants to interact.
+         * @param group_size How many \link Actor Actors \endlink are in the group the Interaction would take place in.
+         * @param day The current day of the simulation.
+         * @return The indices of the plausible \link Interaction Interactions \endlink, sorted by unlock day and then in catalogue order.
+         */
+        CandidateRange GetCandidateIndices(ContextType context, GoalType goal_type, size_t group_size, size_t day) const;
+        /**
+         * @brief Checks the emotion requirements of the active Actor for the whole catalogue in one pass.
+         *
+         * The thresholds are stored as lower and upper bounds per EmotionType in separate arrays, so the check is a branchless comparison over
+         * consecutive floats. Bit i % 64 of word i / 64 is set if Interaction i allows the passed emotions.
+         *
+         * @param [in] emotions The values of the Actor for each EmotionType.
+         * @param [out] out_mask Holds the bitmask. Gets resized to the catalogue size rounded up to full words.
+         */
+        void CalculateEmotionRequirementMask(const EmotionValues &emotions, std::vector<uint64_t> &out_mask) const;
+        /**
+         * @brief Returns how much an Interaction furthers a Goal of the passed GoalType.
+         *
+         * The effects are calculated from the InteractionPrototype once when the catalogue is loaded, so this is a single lookup.
+         *
+         * @param goal_type The GoalType of the Actor.
+         * @param prototype_index Index of the queried InteractionPrototype.
+         * @return The effect, clamped to [-1.0, 1.0]. Always 0 for GoalType::kLast.
+         */
+        float GetGoalEffect(GoalType goal_type, size_t prototype_index) const;
 
     private:
+        /**
+         * @brief Eight consecutive values of one row of the tendency matrix, aligned so a block fills exactly one 256 bit vector register.
+         */
+        struct alignas(32) TendencyBlock
+        {
+            float values[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        };
         /**
          * @brief Holds a reference to the Random object of the simulation.
          */
@@ -129,6 +208,56 @@ namespace tattletale
          * @brief Holds the hard \link InteractionRequirement Requirements \endlink for all available Interaction prototypes.
          */
         std::vector<std::shared_ptr<InteractionTendency>> tendencies_catalogue_;
+        /**
+         * @brief How many \link TendencyBlock TendencyBlocks \endlink each row of the tendency matrix has.
+         */
+        size_t tendency_block_count_ = 0;
+        /**
+         * @brief The InteractionTendency catalogue packed into a feature major matrix.
+         *
+         * Row f holds feature f (see tendency_feature_count_) of every Interaction, padded with zeroes to full blocks.
+         */
+        std::vector<TendencyBlock> tendency_matrix_;
+        /**
+         * @brief All distinct days after which an Interaction of the catalogue becomes possible, ascending.
+         */
+        std::vector<size_t> unlock_days_;
+        /**
+         * @brief All distinct participant counts of the catalogue, ascending.
+         */
+        std::vector<size_t> participant_counts_;
+        /**
+         * @brief The candidates of one combination of ContextType, GoalType and participant count level.
+         */
+        struct CandidateBucket
+        {
+            /**
+             * @brief The catalogue indices, sorted by unlock day and then in catalogue order.
+             */
+            std::vector<size_t> indices;
+            /**
+             * @brief For each entry of unlock_days_ how many indices are unlocked on that day.
+             */
+            std::vector<size_t> day_level_ends;
+        };
+        /**
+         * @brief The candidate lists for GetCandidateIndices.
+         *
+         * Indexed by context, goal type and participant count level, see GetCandidateBucketIndex.
+         */
+        std::vector<CandidateBucket> candidate_buckets_;
+        /**
+         * @brief Lowest allowed value of each EmotionType for the active Actor of each Interaction. Indexed by type index * padded catalogue size + interaction index.
+         */
+        std::vector<float> emotion_minimums_;
+        /**
+         * @brief Highest allowed value of each EmotionType for the active Actor of each Interaction. Indexed by type index * padded catalogue size + interaction index.
+         */
+        std::vector<float> emotion_maximums_;
+        /**
+         * @brief The result of GetGoalEffect for every GoalType, GoalType::kLast included, and Interaction. Indexed by goal index * catalogue size + interaction index.
+         */
+        std::vector<float> goal_effects_;
         /**
          * @brief Path to the json file where Interaction prototypes are defined.
          */
@@ -258,6 +387,31 @@ namespace tattletale
          * @return Wether the process of reading was successful.
          */
         bool ReadTendencyJSON(nlohmann::json json, size_t participant_count, std::string error_preamble, std::shared_ptr<InteractionTendency> &out_tendency);
+        /**
+         * @brief Packs the InteractionTendency catalogue into the tendency matrix.
+         */
+        void BuildTendencyMatrix();
+        /**
+         * @brief Sorts the catalogue into the candidate lists used by GetCandidateIndices.
+         */
+        void BuildCandidateBuckets();
+        /**
+         * @brief Converts the emotion requirements of the catalogue into emotion_minimums_ and emotion_maximums_.
+         */
+        void BuildEmotionRequirementBounds();
+        /**
+         * @brief Calculates the effect of every Interaction on every GoalType into goal_effects_.
+         */
+        void BuildGoalEffects();
+        /**
+         * @brief Calculates the position of a candidate list in candidate_buckets_.
+         *
+         * @param context_index The index of the ContextType, ContextType::kLast included.
+         * @param goal_index The index of the GoalType, GoalType::kLast included.
+         * @param count_level The index into participant_counts_.
+         * @return The position in candidate_buckets_.
+         */
+        size_t GetCandidateBucketIndex(size_t context_index, size_t goal_index, size_t count_level) const;
 
         /**
          * @brief Reads a value of type T from a json object mapping to a dictionary.
@@ -0,0 +1,246 @@
+#include "tale/relationshipstore.hpp"
+#include <algorithm>
+
+namespace tattletale
+{
+    RelationshipStore::RelationshipStore(size_t actor_count, size_t dense_actor_limit) : dense_(actor_count <= dense_actor_limit)
+    {
+        if (dense_)
+        {
+            GrowDense(actor_count);
+        }
+    }
+
+    void RelationshipStore::AddActor(size_t actor_id)
+    {
+        if (actor_id >= relationship_counts_.size())
+        {
+            relationship_counts_.resize(actor_id + 1, 0);
+            sorted_values_.resize((actor_id + 1) * type_count_);
+        }
+        if (dense_)
+        {
+            if (actor_id >= dense_capacity_)
+            {
+                GrowDense(std::max(actor_id + 1, dense_capacity_ * 2));
+            }
+        }
+        else if (actor_id >= sparse_rows_.size())
+        {
+            sparse_rows_.resize(actor_id + 1);
+        }
+    }
+
+    bool RelationshipStore::IsDense() const
+    {
+        return dense_;
+    }
+
+    bool RelationshipStore::HasRelationship(size_t actor_id, size_t other_actor_id) const
+    {
+        return GetRelationship(actor_id, other_actor_id) != nullptr;
+    }
+
+    const float *RelationshipStore::GetRelationship(size_t actor_id, size_t other_actor_id) const
+    {
+        if (dense_)
+        {
+            size_t pair_index = actor_id * dense_capacity_ + other_actor_id;
+            if (!dense_known_[pair_index])
+            {
+                return nullptr;
+            }
+            return &dense_values_[pair_index * type_count_];
+        }
+        const SparseRow &row = sparse_rows_[actor_id];
+        uint32_t position = FindInRow(row, other_actor_id);
+        if (position == empty_slot_)
+        {
+            return nullptr;
+        }
+        return &row.values[position * type_count_];
+    }
+
+    void RelationshipStore::SetRelationship(size_t actor_id, size_t other_actor_id, const float *values)
+    {
+        float previous_values[type_count_];
+        const float *previous_relationship = GetRelationship(actor_id, other_actor_id);
+        if (previous_relationship)
+        {
+            std::copy(previous_relationship, previous_relationship + type_count_, previous_values);
+        }
+        UpdateSortedValues(actor_id, other_actor_id, previous_relationship ? previous_values : nullptr, values);
+        if (dense_)
+        {
+            size_t pair_index = actor_id * dense_capacity_ + other_actor_id;
+            if (!dense_known_[pair_index])
+            {
+                dense_known_[pair_index] = 1;
+                ++relationship_counts_[actor_id];
+            }
+            std::copy(values, values + type_count_, dense_values_.begin() + pair_index * type_count_);
+            return;
+        }
+        SparseRow &row = sparse_rows_[actor_id];
+        uint32_t position = FindInRow(row, other_actor_id);
+        if (position == empty_slot_)
+        {
+            auto it = std::lower_bound(row.other_actor_ids.begin(), row.other_actor_ids.end(), static_cast<uint32_t>(other_actor_id));
+            position = static_cast<uint32_t>(it - row.other_actor_ids.begin());
+            row.other_actor_ids.insert(it, static_cast<uint32_t>(other_actor_id));
+            row.values.insert(row.values.begin() + position * type_count_, type_count_, 0.0f);
+            ++relationship_counts_[actor_id];
+            RebuildRowIndex(row);
+        }
+        std::copy(values, values + type_count_, row.values.begin() + position * type_count_);
+    }
+
+    size_t RelationshipStore::GetRelationshipCount(size_t actor_id) const
+    {
+        return relationship_counts_[actor_id];
+    }
+
+    bool RelationshipStore::HasRelationshipWithinThresholds(size_t actor_id, const RelationshipValues &thresholds) const
+    {
+        using SortedEntry = std::pair<float, uint32_t>;
+        auto value_less = [](const SortedEntry &entry, float value)
+        { return entry.first < value; };
+        auto less_value = [](float value, const SortedEntry &entry)
+        { return value < entry.first; };
+
+        // find the threshold with the fewest candidates
+        const SortedEntry *candidates_begin = nullptr;
+        const SortedEntry *candidates_end = nullptr;
+        bool has_threshold = false;
+        for (size_t type_index = 0; type_index < type_count_; ++type_index)
+        {
+            float threshold = thresholds[type_index];
+            if (threshold == 0)
+            {
+                continue;
+            }
+            const std::vector<SortedEntry> &sorted = sorted_values_[actor_id * type_count_ + type_index];
+            const SortedEntry *begin = sorted.data();
+            const SortedEntry *end = sorted.data() + sorted.size();
+            if (threshold < 0)
+            {
+                end = std::upper_bound(begin, end, threshold, less_value);
+            }
+            else
+            {
+                begin = std::lower_bound(begin, end, threshold, value_less);
+            }
+            if (begin == end)
+            {
+                return false;
+            }
+            if (!has_threshold || (end - begin) < (candidates_end - candidates_begin))
+            {
+                candidates_begin = begin;
+                candidates_end = end;
+                has_threshold = true;
+            }
+        }
+        if (!has_threshold)
+        {
+            return relationship_counts_[actor_id] > 0;
+        }
+
+        for (const SortedEntry *candidate = candidates_begin; candidate != candidates_end; ++candidate)
+        {
+            const float *relationship = GetRelationship(actor_id, candidate->second);
+            bool match_found = true;
+            for (size_t type_index = 0; type_index < type_count_ && match_found; ++type_index)
+            {
+                float threshold = thresholds[type_index];
+                if (threshold < 0)
+                {
+                    match_found = relationship[type_index] <= threshold;
+                }
+                else if (threshold > 0)
+                {
+                    match_found = relationship[type_index] >= threshold;
+                }
+            }
+            if (match_found)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void RelationshipStore::UpdateSortedValues(size_t actor_id, size_t other_actor_id, const float *previous_values, const float *values)
+    {
+        uint32_t other_id = static_cast<uint32_t>(other_actor_id);
+        for (size_t type_index = 0; type_index < type_count_; ++type_index)
+        {
+            std::vector<std::pair<float, uint32_t>> &sorted = sorted_values_[actor_id * type_count_ + type_index];
+            if (previous_values)
+            {
+                if (previous_values[type_index] == values[type_index])
+                {
+                    continue;
+                }
+                auto previous = std::lower_bound(sorted.begin(), sorted.end(), std::make_pair(previous_values[type_index], other_id));
+                sorted.erase(previous);
+            }
+            auto next = std::lower_bound(sorted.begin(), sorted.end(), std::make_pair(values[type_index], other_id));
+            sorted.insert(next, std::make_pair(values[type_index], other_id));
+        }
+    }
+
+    void RelationshipStore::GrowDense(size_t capacity)
+    {
+        std::vector<float> values(capacity * capacity * type_count_, 0.0f);
+        std::vector<uint8_t> known(capacity * capacity, 0);
+        for (size_t actor_id = 0; actor_id < dense_capacity_; ++actor_id)
+        {
+            size_t old_row = actor_id * dense_capacity_;
+            size_t new_row = actor_id * capacity;
+            std::copy(dense_known_.begin() + old_row, dense_known_.begin() + old_row + dense_capacity_, known.begin() + new_row);
+            std::copy(dense_values_.begin() + old_row * type_count_, dense_values_.begin() + (old_row + dense_capacity_) * type_count_, values.begin() + new_row * type_count_);
+        }
+        dense_values_ = std::move(values);
+        dense_known_ = std::move(known);
+        dense_capacity_ = capacity;
+    }
+
+    uint32_t RelationshipStore::FindInRow(const SparseRow &row, size_t other_actor_id) const
+    {
+        if (row.index.empty())
+        {
+            return empty_slot_;
+        }
+        size_t mask = row.index.size() - 1;
+        for (size_t slot = HashActorId(other_actor_id) & mask;; slot = (slot + 1) & mask)
+        {
+            uint32_t position = row.index[slot];
+            if (position == empty_slot_ || row.other_actor_ids[position] == other_actor_id)
+            {
+                return position;
+            }
+        }
+    }
+
+    void RelationshipStore::RebuildRowIndex(SparseRow &row)
+    {
+        // keep the load factor at or below one half so probing sequences stay short
+        size_t size = 4;
+        while (size < row.other_actor_ids.size() * 2)
+        {
+            size *= 2;
+        }
+        row.index.assign(size, empty_slot_);
+        size_t mask = size - 1;
+        for (uint32_t position = 0; position < row.other_actor_ids.size(); ++position)
+        {
+            size_t slot = HashActorId(row.other_actor_ids[position]) & mask;
+            while (row.index[slot] != empty_slot_)
+            {
+                slot = (slot + 1) & mask;
+            }
+            row.index[slot] = position;
+        }
+    }
+} // namespace tattletale
@@ -0,0 +1,194 @@
+#ifndef TALE_RELATIONSHIPSTORE_H
+#define TALE_RELATIONSHIPSTORE_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "shared/kernels/resourcekernels/relationship.hpp"
+
+namespace tattletale
+{
+    /**
+     * @brief Stores the current values of every Relationship between \link Actor Actors \endlink.
+     *
+     * The Relationship \link Kernel Kernels \endlink an Actor holds are only kept for provenance, every hot read goes through this store.
+     * For small schools the values live in a dense matrix of actor count x actor count x RelationshipType::kLast floats, so a lookup is a single
+     * index calculation. Above the dense actor limit that matrix would get too big, so each Actor instead gets a row of its
+     * known \link Actor Actors \endlink sorted by id, with the values of each Relationship next to each other, and a small open addressed
+     * index mapping the id of the other Actor to its position in the row.
+     *
+     * Independent of the layout every Actor also has one list per RelationshipType holding the values of all its \link Relationship Relationships \endlink
+     * sorted ascending. This allows answering threshold queries like "does any known Actor have love >= x and anger <= y" by only
+     * looking at the candidates of the most selective threshold.
+     */
+    class RelationshipStore
+    {
+    public:
+        /**
+         * @brief How many values each Relationship consists of, one per RelationshipType.
+         */
+        static constexpr size_t type_count_ = static_cast<size_t>(RelationshipType::kLast);
+        /**
+         * @brief Up to which actor count the dense matrix is used by default.
+         */
+        static constexpr size_t default_dense_actor_limit_ = 256;
+        /**
+         * @brief Constructor deciding wether the dense or the sparse layout will be used.
+         *
+         * @param actor_count How many \link Actor Actors \endlink the simulation will start with.
+         * @param dense_actor_limit Up to which actor count the dense matrix is used.
+         */
+        RelationshipStore(size_t actor_count, size_t dense_actor_limit = default_dense_actor_limit_);
+        /**
+         * @brief Makes room for the Actor with the passed id.
+         *
+         * @param actor_id The id of the Actor that is being added.
+         */
+        void AddActor(size_t actor_id);
+        /**
+         * @brief Checks wether the store uses the dense matrix layout.
+         *
+         * @return The result of the check.
+         */
+        bool IsDense() const;
+        /**
+         * @brief Checks wether an Actor has a Relationship with another Actor.
+         *
+         * @param actor_id The id of the Actor owning the Relationship.
+         * @param other_actor_id The id of the Actor the Relationship is directed at.
+         * @return The result of the check.
+         */
+        bool HasRelationship(size_t actor_id, size_t other_actor_id) const;
+        /**
+         * @brief Getter for the values of a Relationship.
+         *
+         * @param actor_id The id of the Actor owning the Relationship.
+         * @param other_actor_id The id of the Actor the Relationship is directed at.
+         * @return Pointer to type_count_ values indexed by RelationshipType, nullptr if the \link Actor Actors \endlink have no Relationship.
+         */
+        const float *GetRelationship(size_t actor_id, size_t other_actor_id) const;
+        /**
+         * @brief Sets the values of a Relationship, creating it if it did not exist yet.
+         *
+         * @param actor_id The id of the Actor owning the Relationship.
+         * @param other_actor_id The id of the Actor the Relationship is directed at.
+         * @param values Pointer to type_count_ values indexed by RelationshipType.
+         */
+        void SetRelationship(size_t actor_id, size_t other_actor_id, const float *values);
+        /**
+         * @brief Getter for the amount of \link Relationship Relationships \endlink an Actor has.
+         *
+         * @param actor_id The id of the Actor.
+         * @return The amount of \link Relationship Relationships \endlink.
+         */
+        size_t GetRelationshipCount(size_t actor_id) const;
+        /**
+         * @brief Checks wether an Actor has at least one Relationship that meets all passed thresholds.
+         *
+         * Uses the same rules as the relationship part of an InteractionRequirement: a negative threshold is met by values lower or equal to it,
+         * a positive threshold by values greater or equal to it and a threshold of 0 is always met.
+         * Only the \link Relationship Relationships \endlink inside the value range of the most selective threshold are checked one by one.
+         *
+         * @param actor_id The id of the Actor owning the \link Relationship Relationships \endlink.
+         * @param thresholds One threshold per RelationshipType.
+         * @return The result of the check. Also true if no threshold is set and the Actor has any Relationship.
+         */
+        bool HasRelationshipWithinThresholds(size_t actor_id, const RelationshipValues &thresholds) const;
+
+    private:
+        /**
+         * @brief Marks an unused entry of the open addressed index of a SparseRow.
+         */
+        static constexpr uint32_t empty_slot_ = UINT32_MAX;
+        /**
+         * @brief Holds the \link Relationship Relationships \endlink of one Actor in the sparse layout.
+         */
+        struct SparseRow
+        {
+            /**
+             * @brief The ids of all known \link Actor Actors \endlink, sorted ascending.
+             */
+            std::vector<uint32_t> other_actor_ids;
+            /**
+             * @brief type_count_ values per entry of other_actor_ids.
+             */
+            std::vector<float> values;
+            /**
+             * @brief Open addressed table with linear probing mapping an Actor id to its position in other_actor_ids. Its size is always a power of two.
+             */
+            std::vector<uint32_t> index;
+        };
+        /**
+         * @brief Wether the dense matrix layout is used.
+         */
+        bool dense_;
+        /**
+         * @brief How many \link Actor Actors \endlink the dense matrix currently has room for in each dimension.
+         */
+        size_t dense_capacity_ = 0;
+        /**
+         * @brief The dense matrix, type_count_ values for each pair of \link Actor Actors \endlink.
+         */
+        std::vector<float> dense_values_;
+        /**
+         * @brief Holds for each pair of \link Actor Actors \endlink in the dense matrix wether a Relationship exists.
+         */
+        std::vector<uint8_t> dense_known_;
+        /**
+         * @brief The amount of \link Relationship Relationships \endlink of each Actor.
+         */
+        std::vector<size_t> relationship_counts_;
+        /**
+         * @brief The rows of the sparse layout, one per Actor.
+         */
+        std::vector<SparseRow> sparse_rows_;
+        /**
+         * @brief For each Actor and RelationshipType the values of all its \link Relationship Relationships \endlink paired with the id of the other Actor, sorted ascending.
+         *
+         * Indexed by actor id * type_count_ + type index.
+         */
+        std::vector<std::vector<std::pair<float, uint32_t>>> sorted_values_;
+
+        /**
+         * @brief Grows the dense matrix so it has room for at least the passed amount of \link Actor Actors \endlink.
+         *
+         * @param capacity The new minimum capacity.
+         */
+        void GrowDense(size_t capacity);
+        /**
+         * @brief Finds the position of an Actor in a SparseRow.
+         *
+         * @param row The row to search in.
+         * @param other_actor_id The id of the Actor to search for.
+         * @return The position in other_actor_ids or empty_slot_ if it is not part of the row.
+         */
+        uint32_t FindInRow(const SparseRow &row, size_t other_actor_id) const;
+        /**
+         * @brief Rebuilds the open addressed index of a SparseRow after its order changed.
+         *
+         * @param row The row whose index will be rebuilt.
+         */
+        void RebuildRowIndex(SparseRow &row);
+        /**
+         * @brief Moves the changed values of a Relationship to their new place in the sorted value lists.
+         *
+         * @param actor_id The id of the Actor owning the Relationship.
+         * @param other_actor_id The id of the Actor the Relationship is directed at.
+         * @param previous_values The values before the change, nullptr if the Relationship is new.
+         * @param values The new values.
+         */
+        void UpdateSortedValues(size_t actor_id, size_t other_actor_id, const float *previous_values, const float *values);
+        /**
+         * @brief Hashes an Actor id for the open addressed index.
+         *
+         * @param other_actor_id The id to hash.
+         * @return The hash.
+         */
+        static size_t HashActorId(size_t other_actor_id)
+        {
+            return static_cast<size_t>(static_cast<uint32_t>(other_actor_id) * 2654435761u);
+        }
+    };
+
+} // namespace tattletale
+#endif // TALE_RELATIONSHIPSTORE_H
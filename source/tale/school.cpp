@@ -13,7 +13,12 @@ namespace tattletale
     School::School(Chronicle &chronicle, Random &random, const Setting &setting) : setting_(setting), random_(random), chronicle_(chronicle), interaction_store_(random_)
     {
         size_t actor_count = setting_.actor_count;
-        chronicle_.Reset();
+        chronicle_.Reset(actor_count);
+        if (setting_.spill_tick_horizon > 0)
+        {
+            bool spilling_enabled = chronicle_.EnableSpilling(setting_.spill_path, setting_.spill_tick_horizon);
+            TATTLETALE_ERROR_PRINT(spilling_enabled, fmt::format("Could not open spill file {}", setting_.spill_path));
+        }
         size_t tick = 0;
 
         std::vector<std::string> firstnames = GetRandomFirstnames(actor_count);
@@ -131,6 +136,7 @@ namespace tattletale
         for (size_t i = 0; i < days; ++i)
         {
             SimulateDay(current_day_, current_weekday_);
+            chronicle_.SpillOldKernels(current_tick_);
             ++current_day_;
             current_weekday_ = static_cast<Weekday>((static_cast<int>(current_weekday_) + 1) % 7);
 
@@ -231,7 +237,8 @@ namespace tattletale
                     std::list<Actor *> course_group = course.GetCourseGroupForSlot(slot);
                     for (auto &actor : course_group)
                     {
-                        LetActorInteract(actor, course_group, ContextType::kCourse, fmt::format("During Slot {} in Course \"{}\"", i, course.name_));
+                        LetActorInteract(actor, course_group, ContextType::kCourse, [&]()
+                                         { return fmt::format("During Slot {} in Course \"{}\"", i, course.name_); });
                     }
                 }
                 ++current_tick_;
@@ -253,24 +260,30 @@ namespace tattletale
     {
         for (auto &actor : actors_)
         {
-            LetActorInteract(actor, actor->GetFreetimeActorGroup(), ContextType::kFreetime, "Freetime");
+            LetActorInteract(actor, actor->GetFreetimeActorGroup(), ContextType::kFreetime, []()
+                             { return std::string("Freetime"); });
         }
     }
 
-    void School::LetActorInteract(Actor *&actor, const std::list<Actor *> &group, ContextType context_type, std::string context_description)
+    template <typename DescribeContext>
+    void School::LetActorInteract(Actor *&actor, const std::list<Actor *> &group, ContextType context_type, const DescribeContext &describe_context)
     {
-        std::vector<Kernel *> reasons;
-        std::vector<Actor *> participants;
+        interaction_reasons_.clear();
+        interaction_participants_.clear();
+        // both lists become the storage of the Interaction, so they are allocated once with room for the biggest one instead of growing
+        size_t max_participant_count = interaction_store_.GetMaxParticipantCount();
+        interaction_reasons_.reserve(max_participant_count + 1);
+        interaction_participants_.reserve(max_participant_count);
         float chance;
-        int interaction_index = actor->ChooseInteraction(group, context_type, reasons, participants, chance);
-        std::string interaction_description = fmt::format("{} did nothing.", actor->name_);
+        int interaction_index = actor->ChooseInteraction(group, context_type, interaction_reasons_, interaction_participants_, chance);
+        Interaction *interaction = nullptr;
         if (interaction_index != -1)
         {
-            Interaction *interaction = interaction_store_.CreateInteraction(chronicle_, interaction_index, chance, current_tick_, reasons, participants);
+            interaction = interaction_store_.CreateInteraction(chronicle_, interaction_index, chance, current_tick_, std::move(interaction_reasons_), std::move(interaction_participants_));
             interaction->Apply();
-            interaction_description = fmt::format("{}", *interaction);
         }
-        TATTLETALE_VERBOSE_PRINT(fmt::format("During {} {}", context_description, interaction_description));
+        // the descriptions are only built if verbose output is compiled in and enabled
+        TATTLETALE_VERBOSE_PRINT(fmt::format("During {} {}", describe_context(), (interaction ? fmt::format("{}", *interaction) : fmt::format("{} did nothing.", actor->name_))));
     }
     bool School::IsWorkday(Weekday weekday) const
     {
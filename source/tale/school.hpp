@@ -55,6 +55,12 @@ namespace tattletale
          * @param days How many days we want to simulate
          */
         void SimulateDays(size_t days);
+        /**
+         * @brief Simulates a tick where the  \link Actor Actors \endlink have free time.
+         *
+         * Does not advance the current tick, SimulateDays takes care of that.
+         */
+        void FreeTimeTick();
         /**
          * @brief Getter for an Actor
          *
@@ -143,6 +149,14 @@ namespace tattletale
          * @brief The current Weekday. This is always the Weekday that will be simulated next.
          */
         Weekday current_weekday_ = Weekday::Monday;
+        /**
+         * @brief Collects the reasons of the Interaction chosen in LetActorInteract. Moved into the Interaction if one gets created, reused otherwise.
+         */
+        std::vector<Kernel *> interaction_reasons_;
+        /**
+         * @brief Collects the participants of the Interaction chosen in LetActorInteract. Moved into the Interaction if one gets created, reused otherwise.
+         */
+        std::vector<Actor *> interaction_participants_;
         /**
          * @brief Simulates a single day.
          *
@@ -152,10 +166,6 @@ namespace tattletale
          * @param weekday Which Weekday we want to simulate.
          */
         void SimulateDay(size_t day, Weekday weekday);
-        /**
-         * @brief Simulates a tick where the  \link Actor Actors \endlink have free time.
-         */
-        void FreeTimeTick();
         /**
          * @brief Checks wheter the passed Weeekday is a workday or not.
          *
@@ -172,9 +182,10 @@ namespace tattletale
          * @param actor The Actor that will interact.
          * @param group The group in which the Actor will look for other particpants.
          * @param context_type The ContextType in which the Interaction will take place.
-         * @param context_description String describing the context for debugging purposes.
+         * @param describe_context Callable returning a string describing the context for debugging purposes. Only called if the description gets printed.
          */
-        void LetActorInteract(Actor *&actor, const std::list<Actor *> &group, ContextType context_type, std::string context_description = "an unknown time");
+        template <typename DescribeContext>
+        void LetActorInteract(Actor *&actor, const std::list<Actor *> &group, ContextType context_type, const DescribeContext &describe_context);
         /**
          * @brief Checks wheter the passed Actor is in the passed course group.
          *
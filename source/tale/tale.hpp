@@ -12,6 +12,9 @@
 #include "shared/kernels/resourcekernels/relationship.hpp"
 #include "shared/random.hpp"
 #include "shared/chronicle.hpp"
+#include "shared/mappedchronicle.hpp"
+#include "shared/chroniclearchive.hpp"
+#include "shared/chroniclecolumns.hpp"
 #include "shared/setting.hpp"
 #include "tale/interactionstore.hpp"
 #include "shared/actor.hpp"
@@ -0,0 +1,70 @@
+#include "tattle/chainstream.hpp"
+
+namespace tattletale
+{
+    ChainStream::ChainStream(const MappedChronicle &chronicle, size_t chain_size, size_t block_size) : chronicle_(chronicle), chain_size_(chain_size), block_size_(block_size > 0 ? block_size : 1)
+    {
+        chronicle_.Prefetch(0, block_size_);
+    }
+
+    bool ChainStream::Next(std::vector<uint32_t> &out_chain)
+    {
+        while (true)
+        {
+            if (stack_.empty())
+            {
+                if (root_id_ >= chronicle_.GetKernelAmount())
+                {
+                    return false;
+                }
+                if (root_id_ >= block_end_)
+                {
+                    StartBlock();
+                }
+                if (Enter(static_cast<uint32_t>(root_id_++), out_chain))
+                {
+                    return true;
+                }
+                continue;
+            }
+            Frame &top = stack_.back();
+            MappedChronicle::IdRange consequences = chronicle_.GetConsequences(top.kernel_id);
+            if (top.next_consequence >= consequences.size())
+            {
+                stack_.pop_back();
+                continue;
+            }
+            uint32_t consequence = consequences[top.next_consequence++];
+            if (Enter(consequence, out_chain))
+            {
+                return true;
+            }
+        }
+    }
+
+    void ChainStream::StartBlock()
+    {
+        // no chain of the remaining roots can reach back before the current root
+        chronicle_.Release(released_end_, root_id_);
+        released_end_ = root_id_;
+        block_end_ = root_id_ + block_size_;
+        chronicle_.Prefetch(block_end_, block_end_ + block_size_);
+    }
+
+    bool ChainStream::Enter(uint32_t kernel_id, std::vector<uint32_t> &out_chain)
+    {
+        stack_.push_back({kernel_id, 0});
+        // same rule as Chronicle::GetEveryPossibleChain
+        if (stack_.size() < chain_size_ && chronicle_.GetConsequences(kernel_id).size() > 0)
+        {
+            return false;
+        }
+        out_chain.clear();
+        for (const auto &frame : stack_)
+        {
+            out_chain.push_back(frame.kernel_id);
+        }
+        stack_.pop_back();
+        return true;
+    }
+} // namespace tattletale
@@ -0,0 +1,91 @@
+#ifndef TATTLE_CHAINSTREAM_H
+#define TATTLE_CHAINSTREAM_H
+
+#include <vector>
+#include <cstdint>
+#include "shared/mappedchronicle.hpp"
+
+namespace tattletale
+{
+    /**
+     * @brief Enumerates every chain of a MappedChronicle one at a time, without holding all of them or the whole file in memory.
+     *
+     * Produces the same chains in the same order as Chronicle::GetEveryPossibleChain, as kernel ids.
+     * Every chain starts at a root Kernel and follows consequences, which are always created after their reasons, so all chains of a root
+     * only reach \link Kernel Kernels \endlink with the same or a higher id. The roots are therefore walked in blocks of ascending ids:
+     * when a block starts the data of every Kernel before it gets released and the data of the following block gets prefetched, so the file is read
+     * mostly sequentially and only a sliding window of it stays in memory.
+     */
+    class ChainStream
+    {
+    public:
+        /**
+         * @brief How many root \link Kernel Kernels \endlink are in one block by default.
+         */
+        static constexpr size_t default_block_size_ = 4096;
+        /**
+         * @brief Constructor, the first chain is produced by the first call to Next.
+         *
+         * @param chronicle The opened file, it has to stay open while the stream is used.
+         * @param chain_size The maximum amount of \link Kernel Kernels \endlink in a chain.
+         * @param block_size How many root \link Kernel Kernels \endlink are in one block.
+         */
+        ChainStream(const MappedChronicle &chronicle, size_t chain_size, size_t block_size = default_block_size_);
+        /**
+         * @brief Produces the next chain.
+         *
+         * @param out_chain Receives the kernel ids of the chain, starting with the root.
+         * @return Wether there was another chain, if not out_chain is left untouched.
+         */
+        bool Next(std::vector<uint32_t> &out_chain);
+
+    private:
+        /**
+         * @brief One Kernel of the chain that is currently being followed.
+         */
+        struct Frame
+        {
+            /**
+             * @brief The id of the Kernel.
+             */
+            uint32_t kernel_id;
+            /**
+             * @brief Which of its consequences gets followed next.
+             */
+            size_t next_consequence;
+        };
+        const MappedChronicle &chronicle_;
+        const size_t chain_size_;
+        const size_t block_size_;
+        /**
+         * @brief The id of the next root Kernel.
+         */
+        size_t root_id_ = 0;
+        /**
+         * @brief One past the id of the last root Kernel of the current block.
+         */
+        size_t block_end_ = 0;
+        /**
+         * @brief Every Kernel before this id was released.
+         */
+        size_t released_end_ = 0;
+        /**
+         * @brief The path from the current root to the Kernel that is being followed.
+         */
+        std::vector<Frame> stack_;
+
+        /**
+         * @brief Moves on to the next block of roots, releasing the data of the previous ones and prefetching the one after.
+         */
+        void StartBlock();
+        /**
+         * @brief Adds a Kernel to the current path.
+         *
+         * @param kernel_id The id of the Kernel.
+         * @param out_chain Receives the path if the Kernel ends the chain.
+         * @return Wether the Kernel ended the chain, in that case it is removed from the path again.
+         */
+        bool Enter(uint32_t kernel_id, std::vector<uint32_t> &out_chain);
+    };
+} // namespace tattletale
+#endif // TATTLE_CHAINSTREAM_H
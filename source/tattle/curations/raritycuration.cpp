@@ -8,17 +8,13 @@ namespace tattletale
 
     float RarityCuration::CalculateScore(const std::vector<Kernel *> &chain) const
     {
-        float max_interactions = ceil(static_cast<float>(max_chain_size_) / 2.0f);
-        float score = 0.0f;
-        for (auto &kernel : chain)
-        {
-            float chance = kernel->GetChance();
-            if(chance<1.0f){
-                score += (1 - kernel->GetChance());
-            }
-        }
-        score /= max_interactions;
-        return score;
+        return CalculateScore(chain, [](const Kernel *kernel)
+                              { return kernel->GetChance(); });
+    }
+    float RarityCuration::CalculateScore(const MappedChronicle &chronicle, const std::vector<uint32_t> &chain) const
+    {
+        return CalculateScore(chain, [&chronicle](uint32_t kernel_id)
+                              { return chronicle.GetKernel(kernel_id).chance; });
     }
     Kernel *RarityCuration::GetFirstNoteworthyEvent(const std::vector<Kernel *> &chain) const
     {
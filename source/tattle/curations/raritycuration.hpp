@@ -2,7 +2,9 @@
 #define TATTLE_CURATIONS_RARITYCURATION_H
 
 #include "tattle/curations/curation.hpp"
+#include <cmath>
 #include "shared/random.hpp"
+#include "shared/mappedchronicle.hpp"
 
 namespace tattletale
 {
@@ -11,8 +13,27 @@ namespace tattletale
     public:
         RarityCuration(size_t max_chain_size);
         float CalculateScore(const std::vector<Kernel *> &chain) const override;
+        float CalculateScore(const MappedChronicle &chronicle, const std::vector<uint32_t> &chain) const;
         Kernel *GetFirstNoteworthyEvent(const std::vector<Kernel *> &chain) const override;
         Kernel *GetSecondNoteworthyEvent(const std::vector<Kernel *> &chain) const override;
+
+    private:
+        template <typename Chain, typename GetChance>
+        float CalculateScore(const Chain &chain, GetChance get_chance) const
+        {
+            float max_interactions = ceil(static_cast<float>(max_chain_size_) / 2.0f);
+            float score = 0.0f;
+            for (auto &kernel : chain)
+            {
+                float chance = get_chance(kernel);
+                if (chance < 1.0f)
+                {
+                    score += (1 - chance);
+                }
+            }
+            score /= max_interactions;
+            return score;
+        }
     };
 } // namespace tattletale
 #endif // TATTLE_CURATIONS_RARITYCURATION_H
\ No newline at end of file
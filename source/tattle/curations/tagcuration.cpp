@@ -214,20 +214,18 @@ namespace tattletale
                 auto interaction = dynamic_cast<Interaction *>(kernel);
                 auto prototype = interaction->GetPrototype();
                 int love_index = static_cast<int>(RelationshipType::kLove);
-                for (auto &relationship_effect : prototype->relationship_effects)
+                // undefined effects are zero, so the whole matrix can be scanned
+                for (const auto &relationship_effect : prototype->relationship_effects)
                 {
-                    for (auto &[participant, values] : relationship_effect)
+                    if (relationship_effect.values[love_index] > 0)
                     {
-                        if (values[love_index] > 0)
+                        ++relationship_count;
+                        if (!first_noteworth_event_found)
                         {
-                            ++relationship_count;
-                            if (!first_noteworth_event_found)
-                            {
-                                first_noteworth_event_found = true;
-                                out_first_noteworthy_event = kernel;
-                            }
-                            out_second_noteworthy_event = kernel;
-                        };
+                            first_noteworth_event_found = true;
+                            out_first_noteworthy_event = kernel;
+                        }
+                        out_second_noteworthy_event = kernel;
                     }
                 }
             }
@@ -311,20 +309,18 @@ namespace tattletale
                 auto interaction = dynamic_cast<Interaction *>(kernel);
                 auto prototype = interaction->GetPrototype();
                 int friendship_index = static_cast<int>(RelationshipType::kFriendship);
-                for (auto &relationship_effect : prototype->relationship_effects)
+                // undefined effects are zero, so the whole matrix can be scanned
+                for (const auto &relationship_effect : prototype->relationship_effects)
                 {
-                    for (auto &[participant, values] : relationship_effect)
+                    if (relationship_effect.values[friendship_index] > 0)
                     {
-                        if (values[friendship_index] > 0)
+                        ++friendship_count;
+                        if (!first_noteworth_event_found)
                         {
-                            ++friendship_count;
-                            if (!first_noteworth_event_found)
-                            {
-                                first_noteworth_event_found = true;
-                                out_first_noteworthy_event = kernel;
-                            }
-                            out_second_noteworthy_event = kernel;
-                        };
+                            first_noteworth_event_found = true;
+                            out_first_noteworthy_event = kernel;
+                        }
+                        out_second_noteworthy_event = kernel;
                     }
                 }
             }
@@ -12,7 +12,9 @@
 #include "tattle/curations/tagcuration.hpp"
 #include "tattle/curations/catcuration.hpp"
 #include "tattle/curations/randomcuration.hpp"
+#include "tattle/chainstream.hpp"
 #include <chrono>
+#include <cstdio>
 #include <fmt/chrono.h>
 
 namespace tattletale
@@ -83,7 +85,11 @@ namespace tattletale
         if (tendency->wealth != 0)
         {
             auto last_wealth = chronicle_.GetLastWealth(interaction->tick_, interaction->GetOwner()->id_);
-            float current_influence = last_wealth->GetValue() * tendency->wealth;
+            float current_influence = 0;
+            if (last_wealth)
+            {
+                current_influence = last_wealth->GetValue() * tendency->wealth;
+            }
             if (current_influence < lowest_influence)
             {
                 blocking_resource = last_wealth;
@@ -245,6 +251,11 @@ namespace tattletale
         std::string previous_adjective = "";
         for (auto &emotion : start_status.emotions)
         {
+            // the state before the spill horizon may not be resident anymore
+            if (!emotion)
+            {
+                continue;
+            }
             bool relevant = false;
             for (auto &kernel : kernels)
             {
@@ -287,7 +298,7 @@ namespace tattletale
         }
         for (auto &kernel : kernels)
         {
-            if (kernel->type_ == KernelType::kResource)
+            if (kernel->type_ == KernelType::kResource && start_status.wealth)
             {
                 description += fmt::format(" {} was also {} {}.\n", *start_status.wealth->GetOwner(), start_status.wealth->GetAdjective(), start_status.wealth->GetNameVariant());
                 break;
@@ -427,9 +438,47 @@ namespace tattletale
         }
         curations.clear();
 
+        if (chronicle_.GetSpilledKernelAmount() > 0)
+        {
+            // the chains above only cover what happened within the spill horizon
+            TATTLETALE_DEBUG_PRINT("Whole Simulation Rarity Curation...");
+            narrative += fmt::format(preamble, "Whole Simulation Rarity", CurateWholeSimulation());
+        }
+
         return narrative;
     }
 
+    std::string Curator::CurateWholeSimulation() const
+    {
+        std::string path = setting_.spill_path + ".mapped";
+        MappedChronicle mapped_chronicle;
+        if (!MappedChronicle::Write(chronicle_, path) || !mapped_chronicle.Open(path))
+        {
+            std::remove(path.c_str());
+            return "Whole Simulation Rarity Curation failed. The chronicle could not be written to disk.";
+        }
+        std::string description = DescribeChain(mapped_chronicle, FindRarestChain(mapped_chronicle, setting_.max_chain_size));
+        mapped_chronicle.Close();
+        std::remove(path.c_str());
+        return description;
+    }
+
+    std::string Curator::DescribeChain(const MappedChronicle &chronicle, const std::vector<uint32_t> &chain) const
+    {
+        if (chain.empty())
+        {
+            return "Curation failed. No valid Kernels were created.";
+        }
+        std::string description = "";
+        for (auto kernel_id : chain)
+        {
+            const auto &record = chronicle.GetKernel(kernel_id);
+            size_t day = record.tick / (setting_.courses_per_day + 1);
+            description += fmt::format("Day {}: {} {} {}\n", day, chronicle.GetActorName(record.owner_id), chronicle.GetKernelType(kernel_id), chronicle.GetKernelName(kernel_id));
+        }
+        return description;
+    }
+
     std::string Curator::Narrativize(const std::vector<Kernel *> &chain, const Curation *curation) const
     {
         std::set<size_t> named_actors;
@@ -697,6 +746,25 @@ namespace tattletale
         return Narrativize(chain, curation);
     }
 
+    std::vector<uint32_t> Curator::FindRarestChain(const MappedChronicle &chronicle, size_t max_chain_size)
+    {
+        RarityCuration curation(max_chain_size);
+        ChainStream chains(chronicle, max_chain_size);
+        float highest_score = 0.0f;
+        std::vector<uint32_t> highest_chain;
+        std::vector<uint32_t> chain;
+        while (chains.Next(chain))
+        {
+            float score = curation.CalculateScore(chronicle, chain);
+            if (score > highest_score)
+            {
+                highest_score = score;
+                highest_chain = chain;
+            }
+        }
+        return highest_chain;
+    }
+
     std::vector<Kernel *> Curator::FindBestScoringChain(const std::vector<std::vector<Kernel *>> chains, Curation *curation) const
     {
         float highest_score = 0.0f;
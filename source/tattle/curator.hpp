@@ -3,6 +3,7 @@
 #include "shared/chronicle.hpp"
 #include "shared/setting.hpp"
 #include "tattle/curations/curation.hpp"
+#include "shared/mappedchronicle.hpp"
 
 namespace tattletale
 {
@@ -27,6 +28,22 @@ namespace tattletale
         std::string GetResourceReasonDescription(Resource *resource) const;
 
         Actor *FindMostOccuringActor(const std::vector<Kernel *> &kernels, bool &out_more_actors_present) const;
+        /**
+         * @brief Finds the chain the RarityCuration scores highest in a chronicle file, streaming the chains with a ChainStream instead of loading them.
+         *
+         * @param chronicle The opened file.
+         * @param max_chain_size The maximum amount of \link Kernel Kernels \endlink in a chain.
+         * @return The kernel ids of the chain, empty if no chain scored above 0.
+         */
+        static std::vector<uint32_t> FindRarestChain(const MappedChronicle &chronicle, size_t max_chain_size);
+        /**
+         * @brief Lists what happened in a chain of a chronicle file, one Kernel per line.
+         *
+         * @param chronicle The opened file.
+         * @param chain The kernel ids of the chain.
+         * @return The description.
+         */
+        std::string DescribeChain(const MappedChronicle &chronicle, const std::vector<uint32_t> &chain) const;
 
     private:
         const Chronicle &chronicle_;
@@ -34,6 +51,14 @@ namespace tattletale
 
         std::vector<Kernel *> FindBestScoringChain(const std::vector<std::vector<Kernel *>> chains, Curation *curation) const;
         std::string Curate(const std::vector<std::vector<Kernel *>> &chains, Curation *curation) const;
+        /**
+         * @brief Finds the rarest chain of the whole simulation once the Chronicle spilled \link Kernel Kernels \endlink to disk.
+         *
+         * The Chronicle gets written to a MappedChronicle next to the spill file, whose chains are streamed by FindRarestChain. The file is removed afterwards.
+         *
+         * @return The description of the chain.
+         */
+        std::string CurateWholeSimulation() const;
     };
 
 } // namespace tattletale
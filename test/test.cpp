@@ -4,13 +4,146 @@
 #include <list>
 #include <algorithm>
 #include <memory>
+#include <new>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
 #include "tale/tale.hpp"
+#include "tattle/tattle.hpp"
+#include "tattle/curator.hpp"
+#include "tattle/chainstream.hpp"
+#include "tattle/curations/raritycuration.hpp"
 #include <time.h>
 
 #define GTEST_INFO std::cout << "[   INFO   ] "
 
 using namespace tattletale;
 
+namespace
+{
+    /**
+     * @brief While true every call of the global operator new is counted in allocation_count and remembered in counted_allocations.
+     */
+    bool count_allocations = false;
+    size_t allocation_count = 0;
+    /**
+     * @brief How many counted allocations were freed again while counting, so they were only needed temporarily.
+     */
+    size_t transient_allocation_count = 0;
+    /**
+     * @brief Open addressed set of the pointers returned while counting. Fixed size, so remembering them never allocates itself.
+     */
+    constexpr size_t counted_allocation_slots = 1 << 16;
+    void *counted_allocations[counted_allocation_slots];
+    /**
+     * @brief Marks a slot of counted_allocations whose pointer was freed, so probing continues past it.
+     */
+    void *const freed_allocation = &counted_allocations;
+
+    size_t GetAllocationSlot(void *pointer)
+    {
+        return (reinterpret_cast<std::uintptr_t>(pointer) >> 4) * 2654435761u % counted_allocation_slots;
+    }
+    void StartCountingAllocations()
+    {
+        std::fill(std::begin(counted_allocations), std::end(counted_allocations), nullptr);
+        allocation_count = 0;
+        transient_allocation_count = 0;
+        count_allocations = true;
+    }
+    void StopCountingAllocations()
+    {
+        count_allocations = false;
+    }
+    void RememberAllocation(void *pointer)
+    {
+        // stop remembering before the table gets too full, tests check allocation_count against the limit
+        if (allocation_count > counted_allocation_slots / 2)
+        {
+            return;
+        }
+        size_t slot = GetAllocationSlot(pointer);
+        while (counted_allocations[slot] && counted_allocations[slot] != freed_allocation)
+        {
+            slot = (slot + 1) % counted_allocation_slots;
+        }
+        counted_allocations[slot] = pointer;
+    }
+    void ForgetAllocation(void *pointer)
+    {
+        for (size_t slot = GetAllocationSlot(pointer); counted_allocations[slot]; slot = (slot + 1) % counted_allocation_slots)
+        {
+            if (counted_allocations[slot] == pointer)
+            {
+                counted_allocations[slot] = freed_allocation;
+                ++transient_allocation_count;
+                return;
+            }
+        }
+    }
+    void *Allocate(std::size_t size)
+    {
+        void *pointer = std::malloc(size == 0 ? 1 : size);
+        if (!pointer)
+        {
+            throw std::bad_alloc();
+        }
+        if (count_allocations)
+        {
+            ++allocation_count;
+            RememberAllocation(pointer);
+        }
+        return pointer;
+    }
+    void Deallocate(void *pointer)
+    {
+        if (count_allocations && pointer)
+        {
+            ForgetAllocation(pointer);
+        }
+        std::free(pointer);
+    }
+    /**
+     * @brief Counts how often a list of consequences frees a buffer it allocated itself while growing, which is the only kind of transient allocation a tick needs.
+     *
+     * @param capacity_before The capacity of the list before counting started.
+     * @param size_before The size of the list before counting started.
+     * @param size_after The size of the list after counting stopped.
+     * @return The amount of freed buffers that were allocated while counting.
+     */
+    size_t CountGrowthReallocations(size_t capacity_before, size_t size_before, size_t size_after)
+    {
+        std::vector<Kernel *> list;
+        list.reserve(capacity_before);
+        list.resize(size_before);
+        size_t reallocations = 0;
+        for (size_t i = size_before; i < size_after; ++i)
+        {
+            size_t capacity = list.capacity();
+            list.push_back(nullptr);
+            if (capacity > 0 && list.capacity() != capacity)
+            {
+                ++reallocations;
+            }
+        }
+        // the buffer the list had before was not allocated while counting
+        return (capacity_before > 0 && reallocations > 0) ? reallocations - 1 : reallocations;
+    }
+} // namespace
+
+void *operator new(std::size_t size)
+{
+    return Allocate(size);
+}
+void operator delete(void *pointer) noexcept
+{
+    Deallocate(pointer);
+}
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    Deallocate(pointer);
+}
+
 TEST(TaleKernels, IncreasingKernelId)
 {
     Random random;
@@ -27,10 +160,75 @@ TEST(TaleKernels, IncreasingKernelId)
     Goal *goal = chronicle.CreateGoal(Goal::GetRandomGoalType(random), tick, actor, no_reasons);
     Relationship *relationship = chronicle.CreateRelationship(RelationshipType::kLove, tick, actor, actor, no_reasons, 1);
     Resource *wealth = chronicle.CreateResource("wealth", "wealthy", "poor", tick, actor, no_reasons, 1);
-    EXPECT_EQ(0, emotion->id_);
-    EXPECT_EQ(1, goal->id_);
-    EXPECT_EQ(2, relationship->id_);
-    EXPECT_EQ(3, wealth->id_);
+    EXPECT_EQ(0u, emotion->id_);
+    EXPECT_EQ(1u, goal->id_);
+    EXPECT_EQ(2u, relationship->id_);
+    EXPECT_EQ(3u, wealth->id_);
+}
+TEST(TaleKernels, TimelinesFindLastStateBeforeTick)
+{
+    Random random;
+    Chronicle chronicle(random);
+    std::vector<Kernel *> no_reasons;
+    Setting setting;
+    setting.actor_count = 0;
+    setting.days_to_simulate = 0;
+    School school(chronicle, random, setting);
+    chronicle.Reset();
+    Actor *actor = chronicle.CreateActor(school, "John", "Doe");
+    Emotion *first_happy = chronicle.CreateEmotion(EmotionType::kHappy, 1, actor, no_reasons, 0.1f);
+    Emotion *calm = chronicle.CreateEmotion(EmotionType::kCalm, 2, actor, no_reasons, 0.2f);
+    Resource *first_wealth = chronicle.CreateResource("wealth", "wealthy", "poor", 2, actor, no_reasons, 0.3f);
+    chronicle.CreateEmotion(EmotionType::kHappy, 4, actor, no_reasons, 0.4f);
+    Emotion *third_happy = chronicle.CreateEmotion(EmotionType::kHappy, 4, actor, no_reasons, 0.5f);
+    Resource *second_wealth = chronicle.CreateResource("wealth", "wealthy", "poor", 6, actor, no_reasons, 0.6f);
+
+    EXPECT_EQ(chronicle.GetLastEmotionOfType(1, actor->id_, EmotionType::kHappy), nullptr);
+    EXPECT_EQ(chronicle.GetLastEmotionOfType(2, actor->id_, EmotionType::kHappy), first_happy);
+    EXPECT_EQ(chronicle.GetLastEmotionOfType(4, actor->id_, EmotionType::kHappy), first_happy);
+    EXPECT_EQ(chronicle.GetLastEmotionOfType(5, actor->id_, EmotionType::kHappy), third_happy);
+    EXPECT_EQ(chronicle.GetLastEmotionOfType(100, actor->id_, EmotionType::kCalm), calm);
+    EXPECT_EQ(chronicle.GetLastEmotionOfType(100, actor->id_, EmotionType::kBrave), nullptr);
+    EXPECT_EQ(chronicle.GetLastWealth(2, actor->id_), nullptr);
+    EXPECT_EQ(chronicle.GetLastWealth(6, actor->id_), first_wealth);
+    EXPECT_EQ(chronicle.GetLastWealth(7, actor->id_), second_wealth);
+
+    ActorStatus status = chronicle.FindActorStatusDuringTick(actor->id_, 5);
+    EXPECT_EQ(status.wealth, first_wealth);
+    EXPECT_EQ(status.emotions[static_cast<size_t>(EmotionType::kHappy)], third_happy);
+    EXPECT_EQ(status.emotions[static_cast<size_t>(EmotionType::kCalm)], calm);
+    EXPECT_EQ(status.emotions[static_cast<size_t>(EmotionType::kBrave)], nullptr);
+}
+
+TEST(TaleKernels, RelationshipTimelinesAreKeptPerActorPair)
+{
+    Random random;
+    Chronicle chronicle(random);
+    std::vector<Kernel *> no_reasons;
+    Setting setting;
+    setting.actor_count = 0;
+    setting.days_to_simulate = 0;
+    School school(chronicle, random, setting);
+    chronicle.Reset();
+    Actor *john = chronicle.CreateActor(school, "John", "Doe");
+    Actor *jane = chronicle.CreateActor(school, "Jane", "Doe");
+    Relationship *first_love = chronicle.CreateRelationship(RelationshipType::kLove, 1, john, jane, no_reasons, 0.1f);
+    Relationship *other_direction = chronicle.CreateRelationship(RelationshipType::kLove, 2, jane, john, no_reasons, 0.2f);
+    Relationship *anger = chronicle.CreateRelationship(RelationshipType::kAnger, 2, john, jane, no_reasons, 0.3f);
+    Relationship *second_love = chronicle.CreateRelationship(RelationshipType::kLove, 3, john, jane, no_reasons, 0.4f);
+
+    const auto &timeline = chronicle.GetRelationshipTimeline(john->id_, jane->id_, RelationshipType::kLove);
+    ASSERT_EQ(timeline.size(), 2u);
+    EXPECT_EQ(timeline[0], first_love);
+    EXPECT_EQ(timeline[1], second_love);
+    EXPECT_EQ(chronicle.GetRelationshipTimeline(john->id_, jane->id_, RelationshipType::kAnger).size(), 1u);
+    EXPECT_TRUE(chronicle.GetRelationshipTimeline(john->id_, john->id_, RelationshipType::kLove).empty());
+
+    EXPECT_EQ(chronicle.GetLastRelationshipOfType(1, john->id_, jane->id_, RelationshipType::kLove), nullptr);
+    EXPECT_EQ(chronicle.GetLastRelationshipOfType(3, john->id_, jane->id_, RelationshipType::kLove), first_love);
+    EXPECT_EQ(chronicle.GetLastRelationshipOfType(4, john->id_, jane->id_, RelationshipType::kLove), second_love);
+    EXPECT_EQ(chronicle.GetLastRelationshipOfType(4, john->id_, jane->id_, RelationshipType::kAnger), anger);
+    EXPECT_EQ(chronicle.GetLastRelationshipOfType(4, jane->id_, john->id_, RelationshipType::kLove), other_direction);
 }
 
 class TaleCreateAndRunSchool : public ::testing::Test
@@ -183,7 +381,7 @@ TEST(TaleExtraSchoolTests, CorrectCurrentDayAfterSimulation)
     chronicle.Reset();
     School school(chronicle, random, setting);
     school.SimulateDays(setting.days_to_simulate);
-    EXPECT_EQ(school.GetCurrentDay(), 5);
+    EXPECT_EQ(school.GetCurrentDay(), 5u);
     EXPECT_EQ(school.GetCurrentWeekday(), Weekday::Saturday);
 }
 
@@ -208,6 +406,154 @@ TEST(TaleExtraSchoolTests, InitializedRelationshipsAtStart)
     }
 }
 
+TEST(TaleExtraSchoolTests, FreetimeGroupHoldsStrongestRelationships)
+{
+    Setting setting;
+    setting.actor_count = 50;
+    setting.days_to_simulate = 3;
+    Random random;
+    Chronicle chronicle(random);
+    chronicle.Reset();
+    School school(chronicle, random, setting);
+    school.SimulateDays(setting.days_to_simulate);
+    for (size_t i = 0; i < setting.actor_count; ++i)
+    {
+        auto actor = school.GetActor(i);
+        std::list<Actor *> known_actors = actor->GetAllKnownActors();
+        EXPECT_EQ(known_actors.size(), actor->GetKnownActorCount());
+        float previous_strength = std::numeric_limits<float>::max();
+        for (auto &other_actor : known_actors)
+        {
+            float strength = actor->CalculateRelationshipStrength(other_actor->id_);
+            EXPECT_LE(strength, previous_strength);
+            previous_strength = strength;
+        }
+        std::list<Actor *> freetime_group = actor->GetFreetimeActorGroup();
+        EXPECT_EQ(freetime_group.size(), std::min(setting.freetime_actor_count, known_actors.size()));
+        EXPECT_TRUE(std::equal(freetime_group.begin(), freetime_group.end(), known_actors.begin()));
+    }
+}
+
+TEST(TaleExtraSchoolTests, ActorStateOutlivesSchool)
+{
+    Setting setting;
+    setting.actor_count = 20;
+    setting.days_to_simulate = 2;
+    Random random;
+    Chronicle chronicle(random);
+    std::vector<std::string> known_actors_descriptions;
+    std::vector<float> strengths;
+    {
+        School school(chronicle, random, setting);
+        school.SimulateDays(setting.days_to_simulate);
+        for (size_t i = 0; i < setting.actor_count; ++i)
+        {
+            known_actors_descriptions.push_back(chronicle.GetKnownActorsDescription(i));
+            strengths.push_back(chronicle.actors_[i]->CalculateRelationshipStrength((i + 1) % setting.actor_count));
+        }
+    }
+    // the stores belong to the Chronicle, so the Actors can still be described once the School is gone
+    for (size_t i = 0; i < setting.actor_count; ++i)
+    {
+        EXPECT_EQ(chronicle.GetKnownActorsDescription(i), known_actors_descriptions[i]);
+        EXPECT_EQ(chronicle.actors_[i]->CalculateRelationshipStrength((i + 1) % setting.actor_count), strengths[i]);
+    }
+}
+
+TEST(TaleRelationshipStore, DenseAndSparseLayoutsAgree)
+{
+    size_t actor_count = 40;
+    RelationshipStore dense(actor_count, actor_count);
+    RelationshipStore sparse(actor_count, 0);
+    EXPECT_TRUE(dense.IsDense());
+    EXPECT_FALSE(sparse.IsDense());
+    Random random(1);
+    for (size_t actor_id = 0; actor_id < actor_count; ++actor_id)
+    {
+        dense.AddActor(actor_id);
+        sparse.AddActor(actor_id);
+    }
+    float values[RelationshipStore::type_count_];
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        size_t actor_id = random.GetUInt(0, actor_count - 1);
+        size_t other_actor_id = random.GetUInt(0, actor_count - 1);
+        for (auto &value : values)
+        {
+            value = random.GetFloat(-1.0f, 1.0f);
+        }
+        dense.SetRelationship(actor_id, other_actor_id, values);
+        sparse.SetRelationship(actor_id, other_actor_id, values);
+    }
+    for (size_t actor_id = 0; actor_id < actor_count; ++actor_id)
+    {
+        EXPECT_EQ(dense.GetRelationshipCount(actor_id), sparse.GetRelationshipCount(actor_id));
+        for (size_t other_actor_id = 0; other_actor_id < actor_count; ++other_actor_id)
+        {
+            const float *dense_values = dense.GetRelationship(actor_id, other_actor_id);
+            const float *sparse_values = sparse.GetRelationship(actor_id, other_actor_id);
+            ASSERT_EQ(dense_values == nullptr, sparse_values == nullptr);
+            if (dense_values)
+            {
+                for (size_t type_index = 0; type_index < RelationshipStore::type_count_; ++type_index)
+                {
+                    EXPECT_EQ(dense_values[type_index], sparse_values[type_index]);
+                }
+            }
+        }
+    }
+}
+
+TEST(TaleRelationshipStore, ThresholdQueryMatchesLinearSearch)
+{
+    size_t actor_count = 30;
+    RelationshipStore store(actor_count, 0);
+    Random random(2);
+    for (size_t actor_id = 0; actor_id < actor_count; ++actor_id)
+    {
+        store.AddActor(actor_id);
+    }
+    float values[RelationshipStore::type_count_];
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        size_t actor_id = random.GetUInt(0, actor_count - 1);
+        size_t other_actor_id = random.GetUInt(0, actor_count - 1);
+        for (auto &value : values)
+        {
+            value = random.GetFloat(-1.0f, 1.0f);
+        }
+        store.SetRelationship(actor_id, other_actor_id, values);
+    }
+    RelationshipValues thresholds = {};
+    for (size_t i = 0; i < 2000; ++i)
+    {
+        size_t actor_id = random.GetUInt(0, actor_count - 1);
+        for (auto &threshold : thresholds)
+        {
+            threshold = (random.GetUInt(0, 2) == 0 ? 0.0f : random.GetFloat(-1.0f, 1.0f));
+        }
+        bool expected = false;
+        for (size_t other_actor_id = 0; other_actor_id < actor_count && !expected; ++other_actor_id)
+        {
+            const float *relationship = store.GetRelationship(actor_id, other_actor_id);
+            if (!relationship)
+            {
+                continue;
+            }
+            expected = true;
+            for (size_t type_index = 0; type_index < RelationshipStore::type_count_; ++type_index)
+            {
+                if ((thresholds[type_index] < 0 && relationship[type_index] > thresholds[type_index]) ||
+                    (thresholds[type_index] > 0 && relationship[type_index] < thresholds[type_index]))
+                {
+                    expected = false;
+                }
+            }
+        }
+        EXPECT_EQ(store.HasRelationshipWithinThresholds(actor_id, thresholds), expected);
+    }
+}
+
 TEST(TaleInteractions, CreateRandomInteractionFromStore)
 {
     Random random;
@@ -234,29 +580,307 @@ TEST(TaleInteractions, CreateRandomInteractionFromStore)
     {
         EXPECT_EQ(interaction->GetAllParticipants()[i], school.GetActor(i));
     }
-    for (size_t i = 0; i < interaction->GetPrototype()->wealth_effects.size(); ++i)
+    const InteractionPrototype &prototype = *interaction->GetPrototype();
+    ASSERT_EQ(prototype.participant_count, participant_count);
+    const auto &wealth_effects = interaction_store.GetWealthEffects(interaction_index);
+    const auto &emotion_effects = interaction_store.GetEmotionEffects(interaction_index);
+    const auto &relationship_effects = interaction_store.GetRelationshipEffects(interaction_index);
+    ASSERT_EQ(emotion_effects.size(), participant_count);
+    ASSERT_EQ(relationship_effects.size(), participant_count * participant_count);
+    for (size_t i = 0; i < participant_count; ++i)
     {
-        EXPECT_EQ(interaction->GetPrototype()->wealth_effects[i], interaction_store.GetWealthEffects(interaction_index)[i]);
+        EXPECT_EQ(prototype.GetWealthEffect(i), wealth_effects[i / InteractionPrototype::effect_block_size_].values[i % InteractionPrototype::effect_block_size_]);
+        // every row starts a 256 bit block
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(prototype.GetEmotionEffects(i)) % 32, 0u);
+        bool any_emotion_effect = false;
+        for (size_t type_index = 0; type_index < InteractionPrototype::emotion_type_count_; ++type_index)
+        {
+            EXPECT_EQ(prototype.GetEmotionEffects(i)[type_index], emotion_effects[i].values[type_index]);
+            any_emotion_effect |= (emotion_effects[i].values[type_index] != 0);
+        }
+        EXPECT_EQ(prototype.HasEmotionEffect(i), any_emotion_effect);
+        for (size_t other = 0; other < participant_count; ++other)
+        {
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(prototype.GetRelationshipEffect(i, other)) % 32, 0u);
+            for (size_t type_index = 0; type_index < InteractionPrototype::relationship_type_count_; ++type_index)
+            {
+                EXPECT_EQ(prototype.GetRelationshipEffect(i, other)[type_index], relationship_effects[i * participant_count + other].values[type_index]);
+            }
+        }
     }
-    for (size_t i = 0; i < interaction->GetPrototype()->emotion_effects.size(); ++i)
+}
+
+TEST(TaleInteractions, CheckpointedPrototypeCountsMatchFullScan)
+{
+    Random random;
+    Setting setting;
+    Chronicle chronicle(random);
+    InteractionStore interaction_store(random);
+    chronicle.Reset();
+    setting.actor_count = 0;
+    for (size_t i = 0; i < interaction_store.GetPrototypeCatalogue().size(); ++i)
+    {
+        setting.actor_count = std::max(setting.actor_count, interaction_store.GetParticipantCount(i));
+    }
+    setting.days_to_simulate = 0;
+    School school(chronicle, random, setting);
+    std::vector<Kernel *> no_reasons;
+    std::vector<Interaction *> interactions;
+    for (size_t tick = 0; tick < 300; ++tick)
+    {
+        size_t interaction_index = interaction_store.GetRandomInteractionPrototypeIndex();
+        size_t participant_count = interaction_store.GetParticipantCount(interaction_index);
+        std::vector<Actor *> participants;
+        for (size_t i = 0; i < participant_count; ++i)
+        {
+            participants.push_back(school.GetActor(i));
+        }
+        interactions.push_back(interaction_store.CreateInteraction(chronicle, interaction_index, 1.0f, tick, no_reasons, participants));
+    }
+    for (size_t tick = 0; tick <= 300; tick += 7)
+    {
+        std::vector<size_t> occurences(interaction_store.GetPrototypeCatalogue().size() + 1, 0);
+        for (size_t i = 0; i < tick; ++i)
+        {
+            occurences[interactions[i]->GetPrototype()->id] += 1;
+        }
+        size_t highest = 0;
+        for (size_t i = 1; i < occurences.size(); ++i)
+        {
+            if (occurences[i] > occurences[highest])
+            {
+                highest = i;
+            }
+        }
+        Interaction *expected = nullptr;
+        for (auto interaction : interactions)
+        {
+            if (interaction->GetPrototype()->id == highest)
+            {
+                expected = interaction;
+                break;
+            }
+        }
+        EXPECT_EQ(chronicle.FindMostOccuringInteractionPrototypeForActorBeforeTick(0, tick), expected);
+    }
+}
+
+class TaleSimulatedChronicle : public ::testing::Test
+{
+protected:
+    Setting setting_;
+    Random random_;
+    Chronicle chronicle_;
+    School *school_;
+    TaleSimulatedChronicle() : random_(), chronicle_(random_)
+    {
+        setting_.actor_count = 20;
+        setting_.days_to_simulate = 5;
+        school_ = new School(chronicle_, random_, setting_);
+        school_->SimulateDays(setting_.days_to_simulate);
+    }
+    virtual ~TaleSimulatedChronicle() { delete school_; }
+    void SetUp() {}
+    virtual void TearDown() {}
+};
+
+TEST_F(TaleSimulatedChronicle, KernelQueriesMatchFullScan)
+{
+    const auto &all_kernels = chronicle_.FindKernels(KernelQuery());
+    ASSERT_EQ(all_kernels.size(), chronicle_.GetKernelAmount());
+    for (size_t i = 1; i < all_kernels.size(); ++i)
+    {
+        ASSERT_EQ(all_kernels[i]->id_, i);
+        ASSERT_LE(all_kernels[i - 1]->tick_, all_kernels[i]->tick_);
+    }
+    size_t last_tick = chronicle_.GetLastTick();
+    for (size_t i = 0; i < 200; ++i)
+    {
+        KernelQuery query;
+        if (random_.GetUInt(0, 1))
+        {
+            query.type = static_cast<KernelType>(random_.GetUInt(0, static_cast<uint32_t>(KernelType::kLast)));
+        }
+        if (random_.GetUInt(0, 1))
+        {
+            query.actor_id = random_.GetUInt(0, setting_.actor_count - 1);
+        }
+        if (random_.GetUInt(0, 3) == 0)
+        {
+            query.type = KernelType::kInteraction;
+            query.prototype_id = random_.GetUInt(0, 40);
+        }
+        if (random_.GetUInt(0, 1))
+        {
+            query.first_tick = random_.GetUInt(0, last_tick);
+            query.last_tick = random_.GetUInt(query.first_tick, last_tick);
+        }
+        std::vector<Kernel *> expected;
+        for (auto kernel : all_kernels)
+        {
+            if ((query.type != KernelType::kLast && kernel->type_ != query.type) || kernel->tick_ < query.first_tick || kernel->tick_ > query.last_tick)
+            {
+                continue;
+            }
+            if (query.actor_id != KernelQuery::any_)
+            {
+                bool involved = (kernel->GetOwner()->id_ == query.actor_id);
+                if (kernel->type_ == KernelType::kInteraction)
+                {
+                    const auto &participants = dynamic_cast<Interaction *>(kernel)->GetParticipants();
+                    involved = std::any_of(participants.begin(), participants.end(), [&](const Actor *actor)
+                                           { return actor->id_ == query.actor_id; });
+                }
+                if (!involved)
+                {
+                    continue;
+                }
+            }
+            if (query.prototype_id != KernelQuery::any_ && dynamic_cast<Interaction *>(kernel)->GetPrototype()->id != query.prototype_id)
+            {
+                continue;
+            }
+            expected.push_back(kernel);
+        }
+        EXPECT_EQ(chronicle_.FindKernels(query), expected);
+    }
+}
+
+TEST_F(TaleSimulatedChronicle, RunningStatisticsMatchFullScan)
+{
+    const auto &all_kernels = chronicle_.FindKernels(KernelQuery());
+    Chronicle::KernelTypeCounts type_counts = {};
+    std::vector<size_t> reason_counts(chronicle_.GetReasonCountHistogram().size(), 0);
+    std::vector<size_t> consequence_counts(chronicle_.GetConsequenceCountHistogram().size(), 0);
+    std::vector<Chronicle::KernelTypeCounts> counts_per_tick(chronicle_.GetLastTick() + 1, Chronicle::KernelTypeCounts());
+    std::vector<float> chances;
+    for (auto kernel : all_kernels)
+    {
+        size_t type_index = static_cast<size_t>(kernel->type_);
+        ++type_counts[type_index];
+        ++counts_per_tick[kernel->tick_][type_index];
+        ASSERT_LT(kernel->GetReasons().size(), reason_counts.size());
+        ++reason_counts[kernel->GetReasons().size()];
+        ASSERT_LT(kernel->GetConsequences().size(), consequence_counts.size());
+        ++consequence_counts[kernel->GetConsequences().size()];
+        if (kernel->type_ == KernelType::kInteraction)
+        {
+            chances.push_back(kernel->GetChance());
+        }
+    }
+    for (size_t type_index = 0; type_index < type_counts.size(); ++type_index)
+    {
+        EXPECT_EQ(chronicle_.GetKernelAmount(static_cast<KernelType>(type_index)), type_counts[type_index]);
+    }
+    EXPECT_EQ(chronicle_.GetReasonCountHistogram(), reason_counts);
+    EXPECT_EQ(chronicle_.GetConsequenceCountHistogram(), consequence_counts);
+    EXPECT_EQ(chronicle_.GetKernelCountsPerTick(), counts_per_tick);
+
+    ASSERT_GT(chances.size(), 1u);
+    double mean = 0;
+    for (auto chance : chances)
+    {
+        mean += chance;
+    }
+    mean /= chances.size();
+    double variance = 0;
+    for (auto chance : chances)
+    {
+        variance += (chance - mean) * (chance - mean);
+    }
+    variance /= (chances.size() - 1);
+    EXPECT_NEAR(chronicle_.GetAverageInteractionChance(), mean, 0.001);
+    EXPECT_NEAR(chronicle_.GetInteractionChanceVariance(), variance, 0.001);
+}
+
+TEST(TaleInteractions, CandidateIndicesMatchRequirements)
+{
+    Random random;
+    InteractionStore interaction_store(random);
+    const auto &requirements = interaction_store.GetRequirementCatalogue();
+    for (int context_index = 0; context_index <= static_cast<int>(ContextType::kLast); ++context_index)
     {
-        for (size_t j = 0; j < interaction->GetPrototype()->emotion_effects[i].size(); ++j)
+        ContextType context = static_cast<ContextType>(context_index);
+        for (int goal_index = 0; goal_index <= static_cast<int>(GoalType::kLast); ++goal_index)
         {
-            EXPECT_EQ(interaction->GetPrototype()->emotion_effects[i][j], interaction_store.GetEmotionEffects(interaction_index)[i][j]);
+            GoalType goal_type = static_cast<GoalType>(goal_index);
+            for (size_t group_size = 0; group_size < 8; ++group_size)
+            {
+                for (size_t day = 0; day < 20; ++day)
+                {
+                    std::vector<size_t> expected;
+                    for (size_t i = 0; i < requirements.size(); ++i)
+                    {
+                        const auto &requirement = *requirements[i];
+                        if ((requirement.context == ContextType::kLast || requirement.context == context) &&
+                            (requirement.goal_type == GoalType::kLast || requirement.goal_type == goal_type) &&
+                            requirement.participant_count <= group_size && requirement.day <= day)
+                        {
+                            expected.push_back(i);
+                        }
+                    }
+                    InteractionStore::CandidateRange candidates = interaction_store.GetCandidateIndices(context, goal_type, group_size, day);
+                    for (size_t i = 1; i < candidates.size(); ++i)
+                    {
+                        EXPECT_LE(requirements[candidates.first[i - 1]]->day, requirements[candidates.first[i]]->day);
+                    }
+                    std::vector<size_t> sorted_candidates(candidates.begin(), candidates.end());
+                    std::sort(sorted_candidates.begin(), sorted_candidates.end());
+                    EXPECT_EQ(sorted_candidates, expected);
+                }
+            }
         }
     }
-    for (size_t i = 0; i < interaction->GetPrototype()->relationship_effects.size(); ++i)
+}
+
+TEST(TaleInteractions, EmotionRequirementMaskMatchesThresholds)
+{
+    Random random;
+    InteractionStore interaction_store(random);
+    const auto &requirements = interaction_store.GetRequirementCatalogue();
+    std::vector<uint64_t> mask;
+    for (size_t tries = 0; tries < 1000; ++tries)
     {
-        for (auto &[participant, vector] : interaction->GetPrototype()->relationship_effects[i])
+        std::array<float, static_cast<size_t>(EmotionType::kLast)> emotions;
+        for (auto &emotion : emotions)
         {
-            for (size_t j = 0; j < vector.size(); ++j)
+            emotion = random.GetFloat(-1.0f, 1.0f);
+        }
+        interaction_store.CalculateEmotionRequirementMask(emotions, mask);
+        for (size_t i = 0; i < requirements.size(); ++i)
+        {
+            bool expected = true;
+            for (size_t type_index = 0; type_index < emotions.size(); ++type_index)
             {
-                EXPECT_EQ(vector[j], interaction_store.GetRelationshipEffects(interaction_index)[i].at(participant)[j]);
+                float value = requirements[i]->emotions[0][type_index];
+                if ((value < 0 && emotions[type_index] > value) || (value > 0 && emotions[type_index] < value))
+                {
+                    expected = false;
+                }
             }
+            EXPECT_EQ(static_cast<bool>((mask[i / 64] >> (i % 64)) & 1), expected);
         }
     }
 }
 
+TEST(TaleInteractions, GoalEffectsAreClamped)
+{
+    Random random;
+    InteractionStore interaction_store(random);
+    for (size_t i = 0; i < interaction_store.GetPrototypeCatalogue().size(); ++i)
+    {
+        for (int goal_index = 0; goal_index < static_cast<int>(GoalType::kLast); ++goal_index)
+        {
+            float effect = interaction_store.GetGoalEffect(static_cast<GoalType>(goal_index), i);
+            EXPECT_GE(effect, -1.0f);
+            EXPECT_LE(effect, 1.0f);
+        }
+        EXPECT_EQ(interaction_store.GetGoalEffect(GoalType::kWealth, i), std::clamp(interaction_store.GetWealthEffects(i)[0].values[0], -1.0f, 1.0f));
+        EXPECT_EQ(interaction_store.GetGoalEffect(GoalType::kHedonism, i), std::clamp(interaction_store.GetEmotionEffects(i)[0].values[static_cast<int>(EmotionType::kSatisfied)], -1.0f, 1.0f));
+        EXPECT_EQ(interaction_store.GetGoalEffect(GoalType::kLast, i), 0.0f);
+    }
+}
+
 TEST(TaleInteractions, ApplyInteraction)
 {
     size_t tick = 0;
@@ -270,9 +894,9 @@ TEST(TaleInteractions, ApplyInteraction)
     std::vector<Actor *> participants;
     participants.push_back(school.GetActor(0));
     participants.push_back(school.GetActor(1));
-    std::vector<float> wealth_effects;
-    std::vector<std::vector<float>> emotion_effects;
-    std::vector<robin_hood::unordered_map<size_t, std::vector<float>>> relationship_effects;
+    std::shared_ptr<InteractionPrototype> prototype(new InteractionPrototype());
+    prototype->name = "Test";
+    prototype->SetParticipantCount(participant_count);
     std::vector<float> expected_wealth_values;
     std::vector<std::vector<float>> expected_emotion_values;
     std::vector<robin_hood::unordered_map<size_t, std::vector<float>>> expected_relationship_values;
@@ -280,22 +904,20 @@ TEST(TaleInteractions, ApplyInteraction)
     for (size_t participant_index = 0; participant_index < 2; ++participant_index)
     {
         float sign = signs[participant_index];
-        wealth_effects.push_back(0.5f * sign);
+        prototype->SetWealthEffect(participant_index, 0.5f * sign);
         expected_wealth_values.push_back(0.5f * sign + school.GetActor(participant_index)->wealth_->GetValue());
-        std::vector<float> emotion_vector(static_cast<int>(EmotionType::kLast), 0.0f);
         std::vector<float> expected_emotion_values_vector(static_cast<int>(EmotionType::kLast), 0.0f);
-        for (int type_index = 0; type_index < emotion_vector.size(); ++type_index)
+        for (size_t type_index = 0; type_index < expected_emotion_values_vector.size(); ++type_index)
         {
-            emotion_vector[type_index] = type_index * 0.1f * sign;
+            prototype->SetEmotionEffect(participant_index, static_cast<int>(type_index), type_index * 0.1f * sign);
             expected_emotion_values_vector[type_index] = type_index * 0.1f * sign + school.GetActor(participant_index)->emotions_[type_index]->GetValue();
         }
-        emotion_effects.push_back(emotion_vector);
         expected_emotion_values.push_back(expected_emotion_values_vector);
 
-        std::vector<float> relationship_vector(static_cast<int>(RelationshipType::kLast), 0.0f);
+        RelationshipValues relationship_vector = {};
         std::vector<float> expected_relationship_values_vector(static_cast<int>(RelationshipType::kLast), 0.0f);
         size_t other_participant = (participant_index == 0 ? 1 : 0);
-        for (int type_index = 0; type_index < relationship_vector.size(); ++type_index)
+        for (size_t type_index = 0; type_index < relationship_vector.size(); ++type_index)
         {
             relationship_vector[type_index] = type_index * 0.1f * sign;
 
@@ -309,16 +931,10 @@ TEST(TaleInteractions, ApplyInteraction)
 
             expected_relationship_values_vector[type_index] = existing_value + type_index * 0.1f * sign;
         }
-        robin_hood::unordered_map<size_t, std::vector<float>> participant_relationship_map = {{other_participant, relationship_vector}};
         robin_hood::unordered_map<size_t, std::vector<float>> expected_participant_relationship_map = {{other_participant, expected_relationship_values_vector}};
-        relationship_effects.push_back(participant_relationship_map);
+        prototype->SetRelationshipEffect(participant_index, other_participant, relationship_vector);
         expected_relationship_values.push_back(expected_participant_relationship_map);
     }
-    std::shared_ptr<InteractionPrototype> prototype(new InteractionPrototype());
-    prototype->name = "Test";
-    prototype->wealth_effects = wealth_effects;
-    prototype->emotion_effects = emotion_effects;
-    prototype->relationship_effects = relationship_effects;
     std::shared_ptr<InteractionRequirement> requirement(new InteractionRequirement());
     std::shared_ptr<InteractionTendency> tendency(new InteractionTendency());
     Interaction *interaction = chronicle.CreateInteraction(prototype, requirement, tendency, 1.0f, tick, no_reasons, participants);
@@ -355,25 +971,21 @@ TEST(TaleInteractions, InteractionBecomesReason)
     std::vector<Actor *> participants;
     participants.push_back(school.GetActor(0));
     participants.push_back(school.GetActor(1));
-    std::vector<float> wealth_effects;
-    std::vector<std::vector<float>> emotion_effects;
-    std::vector<robin_hood::unordered_map<size_t, std::vector<float>>> relationship_effects;
+    std::shared_ptr<InteractionPrototype> prototype(new InteractionPrototype());
+    prototype->name = "InteractionBecomesReason";
+    prototype->SetParticipantCount(participant_count);
     for (size_t participant_index = 0; participant_index < participant_count; ++participant_index)
     {
-        wealth_effects.push_back(0.1f);
-        std::vector<float> emotion_vector(static_cast<int>(EmotionType::kLast), 0.1f);
-        emotion_effects.push_back(emotion_vector);
-
-        std::vector<float> relationship_vector(static_cast<int>(RelationshipType::kLast), 0.1f);
+        prototype->SetWealthEffect(participant_index, 0.1f);
+        for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+        {
+            prototype->SetEmotionEffect(participant_index, type_index, 0.1f);
+        }
+        RelationshipValues relationship_vector;
+        relationship_vector.fill(0.1f);
         size_t other_participant = (participant_index == 0 ? 1 : 0);
-        robin_hood::unordered_map<size_t, std::vector<float>> participant_relationship_map = {{other_participant, relationship_vector}};
-        relationship_effects.push_back(participant_relationship_map);
+        prototype->SetRelationshipEffect(participant_index, other_participant, relationship_vector);
     }
-    std::shared_ptr<InteractionPrototype> prototype(new InteractionPrototype());
-    prototype->name = "InteractionBecomesReason";
-    prototype->wealth_effects = wealth_effects;
-    prototype->emotion_effects = emotion_effects;
-    prototype->relationship_effects = relationship_effects;
     prototype->description = "{} did test interaction with {}";
     std::shared_ptr<InteractionRequirement> requirement(new InteractionRequirement());
     requirement->SetParticipantCount(participant_count);
@@ -547,11 +1159,154 @@ TEST_F(TaleActor, CreateActor)
 TEST_F(TaleActor, ActorHasInitializedStartingValues)
 {
     EXPECT_TRUE(actor_->wealth_);
-    EXPECT_NE(actor_->emotions_.size(), 0);
+    EXPECT_NE(actor_->emotions_.size(), 0u);
     GTEST_INFO << "Relationship Size: " << actor_->relationships_.size() << "\n";
     EXPECT_LE(actor_->relationships_.size(), setting_.max_start_relationships_count());
 }
 
+TEST_F(TaleActor, StateStoreMatchesKernels)
+{
+    const ActorStateStore &store = chronicle_.GetActorStateStore();
+    EXPECT_GT(store.GetActorCount(), actor_->id_);
+    EXPECT_EQ(store.GetWealth(actor_->id_), actor_->wealth_->GetValue());
+    for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+    {
+        EXPECT_EQ(store.GetEmotion(actor_->id_, type_index), actor_->emotions_[type_index]->GetValue());
+    }
+    EXPECT_EQ(store.GetGoalType(actor_->id_), actor_->goal_->type_);
+    actor_->ApplyWealthChange(nullptr, 1, 0.25f);
+    EXPECT_EQ(store.GetWealth(actor_->id_), actor_->wealth_->GetValue());
+}
+
+TEST_F(TaleActor, CachedDecisionFollowsStateChanges)
+{
+    const InteractionStore &store = school_->GetInteractionStore();
+    std::list<Actor *> actor_group = actor_->GetAllKnownActors();
+    actor_group.push_front(actor_);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        if (i % 2 == 0)
+        {
+            actor_->ApplyEmotionChange(nullptr, i, static_cast<int>(i % static_cast<size_t>(EmotionType::kLast)), random_.GetFloat(-0.5f, 0.5f));
+        }
+        else
+        {
+            actor_->ApplyWealthChange(nullptr, i, random_.GetFloat(-0.5f, 0.5f));
+        }
+        // the second decision in the same state reuses the cached one
+        for (size_t j = 0; j < 2; ++j)
+        {
+            ContextType context = static_cast<ContextType>(i % static_cast<size_t>(ContextType::kLast));
+            std::vector<Kernel *> reasons;
+            std::vector<Actor *> participants;
+            float chance = 0;
+            int interaction_index = actor_->ChooseInteraction(actor_group, context, reasons, participants, chance);
+            if (interaction_index < 0)
+            {
+                continue;
+            }
+            EXPECT_TRUE(actor_->CheckRequirements(*store.GetRequirementCatalogue()[interaction_index], actor_group, context));
+            Kernel *reason = nullptr;
+            float expected_chance = actor_->CalculateInteractionChance(*store.GetTendencyCatalogue()[interaction_index], context, reason);
+            expected_chance = actor_->ApplyGoalChanceModification(expected_chance, interaction_index, reason);
+            EXPECT_EQ(chance, expected_chance);
+        }
+    }
+}
+
+TEST_F(TaleActor, ChosenParticipantsAreDistinct)
+{
+    const InteractionStore &store = school_->GetInteractionStore();
+    std::list<Actor *> actor_group = actor_->GetAllKnownActors();
+    actor_group.push_front(actor_);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        ContextType context = static_cast<ContextType>(i % static_cast<size_t>(ContextType::kLast));
+        std::vector<Kernel *> reasons;
+        std::vector<Actor *> participants;
+        float chance = 0;
+        int interaction_index = actor_->ChooseInteraction(actor_group, context, reasons, participants, chance);
+        if (interaction_index < 0)
+        {
+            continue;
+        }
+        EXPECT_EQ(participants.size(), store.GetParticipantCount(interaction_index));
+        EXPECT_EQ(participants[0], actor_);
+        for (size_t j = 0; j < participants.size(); ++j)
+        {
+            EXPECT_NE(std::find(actor_group.begin(), actor_group.end(), participants[j]), actor_group.end());
+            for (size_t k = j + 1; k < participants.size(); ++k)
+            {
+                EXPECT_NE(participants[j]->id_, participants[k]->id_);
+            }
+        }
+    }
+}
+
+TEST_F(TaleActor, DecisionDoesNotAllocateInSteadyState)
+{
+    std::vector<Kernel *> reasons;
+    std::vector<Actor *> participants;
+    reasons.reserve(16);
+    participants.reserve(16);
+    float chance = 0;
+    for (size_t round = 0; round < 2; ++round)
+    {
+        // the first round fills every cache and scratch buffer, the second one must not allocate anymore
+        if (round == 1)
+        {
+            StartCountingAllocations();
+        }
+        for (size_t i = 0; i < 100; ++i)
+        {
+            ContextType context = static_cast<ContextType>(i % static_cast<size_t>(ContextType::kLast));
+            const std::list<Actor *> &actor_group = actor_->GetFreetimeActorGroup();
+            reasons.clear();
+            participants.clear();
+            actor_->ChooseInteraction(actor_group, context, reasons, participants, chance);
+        }
+        StopCountingAllocations();
+    }
+    EXPECT_EQ(allocation_count, 0u);
+}
+
+TEST(TaleExtraSchoolTests, FreetimeTickOnlyAllocatesKernelStorage)
+{
+    Setting setting;
+    setting.actor_count = 20;
+    setting.days_to_simulate = 3;
+    Random random;
+    Chronicle chronicle(random);
+    School school(chronicle, random, setting);
+    school.SimulateDays(setting.days_to_simulate);
+    size_t kernel_count = 0;
+    std::vector<std::pair<size_t, size_t>> consequence_sizes;
+    for (size_t round = 0; round < 2; ++round)
+    {
+        // the first round fills every cache and scratch buffer, in the second one every allocation has to end up in a new Kernel or an index of the Chronicle
+        kernel_count = chronicle.GetKernelAmount();
+        if (round == 1)
+        {
+            for (auto kernel : chronicle.FindKernels(KernelQuery()))
+            {
+                consequence_sizes.push_back({kernel->GetConsequences().capacity(), kernel->GetConsequences().size()});
+            }
+            StartCountingAllocations();
+        }
+        school.FreeTimeTick();
+        StopCountingAllocations();
+    }
+    EXPECT_GT(chronicle.GetKernelAmount(), kernel_count);
+    ASSERT_LE(allocation_count, counted_allocation_slots / 2);
+    size_t growth_reallocations = 0;
+    for (auto kernel : chronicle.FindKernels(KernelQuery()))
+    {
+        std::pair<size_t, size_t> before = (kernel->id_ < consequence_sizes.size() ? consequence_sizes[kernel->id_] : std::pair<size_t, size_t>(0, 0));
+        growth_reallocations += CountGrowthReallocations(before.first, before.second, kernel->GetConsequences().size());
+    }
+    EXPECT_EQ(transient_allocation_count, growth_reallocations);
+}
+
 TEST_F(TaleActor, AddActorToCourse)
 {
     size_t course_id = 5;
@@ -560,7 +1315,7 @@ TEST_F(TaleActor, AddActorToCourse)
     std::vector<uint32_t> slots_to_check;
     course_group.push_back(actor_);
     EXPECT_FALSE(actor_->IsEnrolledInCourse(course_id));
-    EXPECT_EQ(actor_->GetFilledSlotsCount(), 0);
+    EXPECT_EQ(actor_->GetFilledSlotsCount(), 0u);
     for (uint32_t i = 0; i < setting_.slot_count_per_week(); ++i)
     {
         slots_to_check.push_back(i);
@@ -597,10 +1352,10 @@ TEST_F(TaleActor, MaxTendencyChanceCalculation)
         tendency.emotions[type_index] = 1.0f;
     }
     std::vector<Kernel *> no_reasons;
-    actor_->wealth_ = chronicle_.CreateResource("wealth", "wealthy", "poor", 0, actor_, no_reasons, 1.0f);
+    actor_->SetWealth(chronicle_.CreateResource("wealth", "wealthy", "poor", 0, actor_, no_reasons, 1.0f));
     for (size_t type_index = 0; type_index < tendency.emotions.size(); ++type_index)
     {
-        actor_->emotions_[type_index] = chronicle_.CreateEmotion(static_cast<EmotionType>(type_index), 0, actor_, no_reasons, 1.0f);
+        actor_->SetEmotion(chronicle_.CreateEmotion(static_cast<EmotionType>(type_index), 0, actor_, no_reasons, 1.0f));
     }
     ContextType context = ContextType::kCourse;
     Kernel *reason;
@@ -624,10 +1379,10 @@ TEST_F(TaleActor, RandomTendencyChanceCalculation)
             tendency.emotions[type_index] = random.GetFloat(-1.0f, 1.0f);
         }
         std::vector<Kernel *> no_reasons;
-        actor_->wealth_ = chronicle_.CreateResource("wealth", "wealthy", "poor", 0, actor_, no_reasons, random.GetFloat(-1.0f, 1.0f));
+            actor_->SetWealth(chronicle_.CreateResource("wealth", "wealthy", "poor", 0, actor_, no_reasons, random.GetFloat(-1.0f, 1.0f)));
         for (size_t type_index = 0; type_index < tendency.emotions.size(); ++type_index)
         {
-            actor_->emotions_[type_index] = chronicle_.CreateEmotion(static_cast<EmotionType>(type_index), 0, actor_, no_reasons, random.GetFloat(-1.0f, 1.0f));
+            actor_->SetEmotion(chronicle_.CreateEmotion(static_cast<EmotionType>(type_index), 0, actor_, no_reasons, random.GetFloat(-1.0f, 1.0f)));
         }
         ContextType context = (random.GetFloat(-1.0f, 1.0f) <= 0 ? ContextType::kCourse : ContextType::kFreetime);
         Kernel *reason;
@@ -636,6 +1391,34 @@ TEST_F(TaleActor, RandomTendencyChanceCalculation)
         EXPECT_LE(chance, 1.0f);
     }
 }
+TEST_F(TaleActor, TendencyMatrixMatchesChanceCalculation)
+{
+    const InteractionStore &store = school_->GetInteractionStore();
+    const auto &tendencies = store.GetTendencyCatalogue();
+    for (int context_index = 0; context_index < static_cast<int>(ContextType::kLast); ++context_index)
+    {
+        ContextType context = static_cast<ContextType>(context_index);
+        std::array<float, InteractionStore::tendency_feature_count_> features;
+        size_t feature_index = 0;
+        for (int type_index = 0; type_index < static_cast<int>(ContextType::kLast); ++type_index)
+        {
+            features[feature_index++] = (context_index == type_index ? 1.0f : -1.0f);
+        }
+        features[feature_index++] = actor_->wealth_->GetValue();
+        for (int type_index = 0; type_index < static_cast<int>(EmotionType::kLast); ++type_index)
+        {
+            features[feature_index++] = actor_->emotions_[type_index]->GetValue();
+        }
+        std::vector<float> chances;
+        store.CalculateTendencyChances(features, chances);
+        ASSERT_GE(chances.size(), tendencies.size());
+        for (size_t i = 0; i < tendencies.size(); ++i)
+        {
+            Kernel *reason = nullptr;
+            EXPECT_EQ(chances[i], actor_->CalculateInteractionChance(*tendencies[i], context, reason));
+        }
+    }
+}
 TEST(TaleRandom, PickIndexWithHundredPercentChance)
 {
     uint32_t seconds = static_cast<uint32_t>(time(NULL));
@@ -660,10 +1443,8 @@ TEST(TaleRandom, PickBetweenFullRangeWithHundredPercentChance)
     uint32_t tries = 1000;
     for (uint32_t i = 0; i < tries; ++i)
     {
-        uint32_t random_index_bottom = random.GetUInt(0, (tries - 1) / 2);
-        uint32_t random_index_top = random.GetUInt(random_index_bottom, tries - 1);
         std::vector<float> distribution(tries, 1.0f);
-        EXPECT_GE(random.PickIndex(distribution), 0);
+        EXPECT_GE(random.PickIndex(distribution), 0u);
         EXPECT_LT(random.PickIndex(distribution), tries);
     }
 }
@@ -674,10 +1455,8 @@ TEST(TaleRandom, PickBetweenFullRangeWithZeroPercentChance)
     uint32_t tries = 1000;
     for (uint32_t i = 0; i < tries; ++i)
     {
-        uint32_t random_index_bottom = random.GetUInt(0, (tries - 1) / 2);
-        uint32_t random_index_top = random.GetUInt(random_index_bottom, tries - 1);
         std::vector<float> distribution(tries, 0.0f);
-        EXPECT_GE(random.PickIndex(distribution, true), 0);
+        EXPECT_GE(random.PickIndex(distribution, true), 0u);
         EXPECT_LT(random.PickIndex(distribution, true), tries);
     }
 }
@@ -699,4 +1478,481 @@ TEST(TaleRandom, PickBetweenRandomRange)
         EXPECT_GE(random.PickIndex(distribution, true), random_index_bottom);
         EXPECT_LE(random.PickIndex(distribution, true), random_index_top);
     }
-}
\ No newline at end of file
+}
+
+TEST(TaleRandom, ReproduciblePickingMatchesDiscreteDistribution)
+{
+    uint32_t seconds = static_cast<uint32_t>(time(NULL));
+    Random weight_random(seconds);
+    Random random(seconds);
+    std::mt19937 rng(seconds);
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        std::vector<float> distribution(weight_random.GetUInt(1, 100));
+        for (auto &chance : distribution)
+        {
+            chance = (weight_random.GetUInt(0, 3) == 0 ? 0.0f : weight_random.GetFloat(0.0f, 1.0f));
+        }
+        distribution[weight_random.GetUInt(0, distribution.size() - 1)] = 1.0f;
+        std::discrete_distribution<size_t> expected_distribution(distribution.begin(), distribution.end());
+        EXPECT_EQ(random.PickIndex(distribution), expected_distribution(rng));
+    }
+}
+TEST(TaleRandom, FastPickingNeverPicksZeroChance)
+{
+    uint32_t seconds = static_cast<uint32_t>(time(NULL));
+    Random random(seconds);
+    random.SetReproduciblePicking(false);
+    uint32_t tries = 1000;
+    for (uint32_t i = 0; i < tries; ++i)
+    {
+        std::vector<float> distribution(random.GetUInt(1, 100));
+        for (auto &chance : distribution)
+        {
+            chance = (random.GetUInt(0, 1) == 0 ? 0.0f : random.GetFloat(0.0f, 1.0f));
+        }
+        distribution[random.GetUInt(0, distribution.size() - 1)] = 1.0f;
+        EXPECT_NE(distribution[random.PickIndex(distribution)], 0.0f);
+    }
+}
+TEST(TaleLogging, DisabledLevelDoesNotEvaluateMessage)
+{
+    size_t evaluations = 0;
+    auto describe = [&]()
+    {
+        ++evaluations;
+        return std::string("");
+    };
+    SetLogLevel(LogLevel::kNone);
+    EXPECT_FALSE(IsLogLevelEnabled(LogLevel::kProgress));
+    TATTLETALE_PROGRESS_PRINT(describe());
+    TATTLETALE_DEBUG_PRINT(describe());
+    TATTLETALE_VERBOSE_PRINT(describe());
+    EXPECT_EQ(evaluations, 0u);
+
+    SetLogLevel(LogLevel::kProgress);
+    EXPECT_TRUE(IsLogLevelEnabled(LogLevel::kProgress));
+    EXPECT_FALSE(IsLogLevelEnabled(LogLevel::kDebug));
+    EXPECT_FALSE(IsLogLevelEnabled(LogLevel::kVerbose));
+    TATTLETALE_DEBUG_PRINT(describe());
+    TATTLETALE_VERBOSE_PRINT(describe());
+    EXPECT_EQ(evaluations, 0u);
+#ifdef TATTLETALE_PROGRESS_PRINT_OUTPUT
+    // an enabled level evaluates its message exactly once
+    TATTLETALE_PROGRESS_PRINT(describe());
+    EXPECT_EQ(evaluations, 1u);
+#endif
+
+    SetLogLevel(LogLevel::kVerbose);
+    EXPECT_TRUE(IsLogLevelEnabled(LogLevel::kDebug));
+    EXPECT_TRUE(IsLogLevelEnabled(LogLevel::kVerbose));
+
+    EXPECT_EQ(StringToLogLevel("none"), LogLevel::kNone);
+    EXPECT_EQ(StringToLogLevel("debug"), LogLevel::kDebug);
+    EXPECT_EQ(StringToLogLevel("loud"), LogLevel::kLast);
+    EXPECT_EQ(Setting().log_level, LogLevel::kVerbose);
+}
+TEST_F(TaleSimulatedChronicle, MappedChronicleMatchesLiveChronicle)
+{
+    std::string path = "mapped_chronicle_test.bin";
+    ASSERT_TRUE(MappedChronicle::Write(chronicle_, path));
+
+    MappedChronicle mapped;
+    ASSERT_TRUE(mapped.Open(path));
+    const auto &kernels = chronicle_.FindKernels(KernelQuery());
+    ASSERT_EQ(mapped.GetKernelAmount(), kernels.size());
+    ASSERT_EQ(mapped.GetActorAmount(), setting_.actor_count);
+    EXPECT_EQ(mapped.GetLastTick(), chronicle_.GetLastTick());
+    for (size_t kernel_id = 0; kernel_id < kernels.size(); ++kernel_id)
+    {
+        Kernel *kernel = kernels[kernel_id];
+        const auto &record = mapped.GetKernel(kernel_id);
+        EXPECT_EQ(mapped.GetKernelType(kernel_id), kernel->type_);
+        EXPECT_EQ(record.tick, kernel->tick_);
+        EXPECT_EQ(record.owner_id, kernel->GetOwner()->id_);
+        EXPECT_EQ(record.chance, kernel->GetChance());
+        EXPECT_EQ(mapped.GetKernelName(kernel_id), kernel->name_);
+        ASSERT_EQ(mapped.GetReasons(kernel_id).size(), kernel->GetReasons().size());
+        for (size_t i = 0; i < kernel->GetReasons().size(); ++i)
+        {
+            EXPECT_EQ(mapped.GetReasons(kernel_id)[i], kernel->GetReasons()[i]->id_);
+        }
+        ASSERT_EQ(mapped.GetConsequences(kernel_id).size(), kernel->GetConsequences().size());
+        const auto &participants = kernel->GetAllParticipants();
+        ASSERT_EQ(mapped.GetParticipants(kernel_id).size(), participants.size());
+        for (size_t i = 0; i < participants.size(); ++i)
+        {
+            EXPECT_EQ(mapped.GetParticipants(kernel_id)[i], participants[i]->id_);
+        }
+    }
+    for (size_t actor_id = 0; actor_id < setting_.actor_count; ++actor_id)
+    {
+        EXPECT_EQ(mapped.GetActorName(actor_id), chronicle_.actors_[actor_id]->name_);
+        for (size_t tick = 0; tick <= chronicle_.GetLastTick() + 1; tick += 5)
+        {
+            Resource *wealth = chronicle_.GetLastWealth(tick, actor_id);
+            EXPECT_EQ(mapped.GetLastWealth(tick, actor_id), (wealth ? wealth->id_ : MappedChronicle::no_id_));
+            Emotion *emotion = chronicle_.GetLastEmotionOfType(tick, actor_id, EmotionType::kHappy);
+            EXPECT_EQ(mapped.GetLastEmotionOfType(tick, actor_id, EmotionType::kHappy), (emotion ? emotion->id_ : MappedChronicle::no_id_));
+        }
+    }
+    mapped.Close();
+    EXPECT_FALSE(mapped.IsOpen());
+    EXPECT_FALSE(mapped.Open("does_not_exist.bin"));
+    std::remove(path.c_str());
+}
+
+TEST(TaleKernels, SpilledKernelsMatchResidentChronicle)
+{
+    Setting setting;
+    setting.actor_count = 20;
+    setting.days_to_simulate = 10;
+    Random resident_random;
+    Chronicle resident_chronicle(resident_random);
+    School resident_school(resident_chronicle, resident_random, setting);
+    resident_school.SimulateDays(setting.days_to_simulate);
+
+    setting.spill_tick_horizon = 10;
+    setting.spill_path = "spilled_chronicle_test.bin";
+    Random random;
+    Chronicle chronicle(random);
+    School school(chronicle, random, setting);
+    school.SimulateDays(setting.days_to_simulate);
+
+    ASSERT_EQ(chronicle.GetKernelAmount(), resident_chronicle.GetKernelAmount());
+    ASSERT_GT(chronicle.GetSpilledKernelAmount(), 0u);
+    EXPECT_EQ(chronicle.FindKernels(KernelQuery()).size() + chronicle.GetSpilledKernelAmount(), chronicle.GetKernelAmount());
+    EXPECT_EQ(chronicle.GetReasonCountHistogram(), resident_chronicle.GetReasonCountHistogram());
+    EXPECT_EQ(chronicle.GetConsequenceCountHistogram(), resident_chronicle.GetConsequenceCountHistogram());
+    EXPECT_EQ(chronicle.GetLastTick(), resident_chronicle.GetLastTick());
+    // the spilled kernels are read back from the spill file, so the written file is the same as the one of the resident chronicle
+    std::string mapped_path = setting.spill_path + ".mapped";
+    std::string resident_mapped_path = setting.spill_path + ".resident.mapped";
+    ASSERT_TRUE(MappedChronicle::Write(chronicle, mapped_path));
+    ASSERT_TRUE(MappedChronicle::Write(resident_chronicle, resident_mapped_path));
+    std::ifstream mapped_file(mapped_path, std::ios::binary);
+    std::ifstream resident_mapped_file(resident_mapped_path, std::ios::binary);
+    std::string mapped_bytes((std::istreambuf_iterator<char>(mapped_file)), std::istreambuf_iterator<char>());
+    std::string resident_mapped_bytes((std::istreambuf_iterator<char>(resident_mapped_file)), std::istreambuf_iterator<char>());
+    EXPECT_FALSE(mapped_bytes.empty());
+    EXPECT_EQ(mapped_bytes, resident_mapped_bytes);
+    mapped_file.close();
+    resident_mapped_file.close();
+    std::remove(mapped_path.c_str());
+    std::remove(resident_mapped_path.c_str());
+    // the same holds for the archive
+    std::string archive_path = setting.spill_path + ".archive";
+    std::string resident_archive_path = setting.spill_path + ".resident.archive";
+    ASSERT_TRUE(ChronicleArchive::Write(chronicle, archive_path));
+    ASSERT_TRUE(ChronicleArchive::Write(resident_chronicle, resident_archive_path));
+    std::ifstream archive_file(archive_path, std::ios::binary);
+    std::ifstream resident_archive_file(resident_archive_path, std::ios::binary);
+    std::string archive_bytes((std::istreambuf_iterator<char>(archive_file)), std::istreambuf_iterator<char>());
+    std::string resident_archive_bytes((std::istreambuf_iterator<char>(resident_archive_file)), std::istreambuf_iterator<char>());
+    EXPECT_FALSE(archive_bytes.empty());
+    EXPECT_EQ(archive_bytes, resident_archive_bytes);
+    archive_file.close();
+    resident_archive_file.close();
+    std::remove(archive_path.c_str());
+    std::remove(resident_archive_path.c_str());
+    // and for every column of the columnar export
+    std::string columns_prefix = setting.spill_path + ".columns";
+    std::string resident_columns_prefix = setting.spill_path + ".resident.columns";
+    ASSERT_TRUE(ChronicleColumns::Write(chronicle, columns_prefix));
+    ASSERT_TRUE(ChronicleColumns::Write(resident_chronicle, resident_columns_prefix));
+    for (auto column : {"id", "tick", "type", "owner", "target", "prototype", "subtype", "chance", "value", "edge_from", "edge_to"})
+    {
+        std::string column_path = ChronicleColumns::GetColumnPath(columns_prefix, column);
+        std::string resident_column_path = ChronicleColumns::GetColumnPath(resident_columns_prefix, column);
+        std::ifstream column_file(column_path, std::ios::binary);
+        std::ifstream resident_column_file(resident_column_path, std::ios::binary);
+        std::string column_bytes((std::istreambuf_iterator<char>(column_file)), std::istreambuf_iterator<char>());
+        std::string resident_column_bytes((std::istreambuf_iterator<char>(resident_column_file)), std::istreambuf_iterator<char>());
+        EXPECT_FALSE(column_bytes.empty()) << column;
+        EXPECT_EQ(column_bytes, resident_column_bytes) << column;
+        column_file.close();
+        resident_column_file.close();
+        std::remove(column_path.c_str());
+        std::remove(resident_column_path.c_str());
+    }
+    std::remove(ChronicleColumns::GetSchemaPath(columns_prefix).c_str());
+    std::remove(ChronicleColumns::GetSchemaPath(resident_columns_prefix).c_str());
+
+    const auto &resident_kernels = resident_chronicle.FindKernels(KernelQuery());
+    const auto &kernels = chronicle.FindKernels(KernelQuery());
+    size_t resident_index = 0;
+    for (size_t kernel_id = 0; kernel_id < resident_kernels.size(); ++kernel_id)
+    {
+        Kernel *expected = resident_kernels[kernel_id];
+        std::vector<size_t> expected_reason_ids;
+        for (auto reason : expected->GetReasons())
+        {
+            expected_reason_ids.push_back(reason->id_);
+        }
+        if (chronicle.IsSpilled(kernel_id))
+        {
+            SpilledKernel spilled_kernel = chronicle.GetSpilledKernel(kernel_id);
+            EXPECT_EQ(spilled_kernel.id, kernel_id);
+            EXPECT_EQ(spilled_kernel.name, expected->name_);
+            EXPECT_EQ(spilled_kernel.record.tick, expected->tick_);
+            EXPECT_EQ(spilled_kernel.record.type, static_cast<uint8_t>(expected->type_));
+            EXPECT_EQ(spilled_kernel.record.owner_id, expected->GetOwner()->id_);
+            EXPECT_EQ(spilled_kernel.record.chance, expected->GetChance());
+            EXPECT_EQ(spilled_kernel.reason_ids, expected_reason_ids);
+            continue;
+        }
+        ASSERT_LT(resident_index, kernels.size());
+        Kernel *kernel = kernels[resident_index++];
+        ASSERT_EQ(kernel->id_, kernel_id);
+        EXPECT_EQ(kernel->name_, expected->name_);
+        EXPECT_EQ(chronicle.GetReasonIds(kernel), expected_reason_ids);
+        for (auto reason : kernel->GetReasons())
+        {
+            EXPECT_FALSE(chronicle.IsSpilled(reason->id_));
+        }
+        for (auto consequence : kernel->GetConsequences())
+        {
+            EXPECT_FALSE(chronicle.IsSpilled(consequence->id_));
+        }
+    }
+    EXPECT_EQ(resident_index, kernels.size());
+
+    // point in time queries are exact from the horizon on, the prototype counts refuse earlier ticks
+    ASSERT_GT(chronicle.GetSpillHorizonTick(), 0u);
+    for (size_t actor_id = 0; actor_id < setting.actor_count; ++actor_id)
+    {
+        for (size_t tick = 0; tick <= chronicle.GetLastTick(); ++tick)
+        {
+            Interaction *interaction = chronicle.FindMostOccuringInteractionPrototypeForActorBeforeTick(actor_id, tick);
+            if (tick < chronicle.GetSpillHorizonTick())
+            {
+                EXPECT_EQ(interaction, nullptr);
+                continue;
+            }
+            Interaction *expected = resident_chronicle.FindMostOccuringInteractionPrototypeForActorBeforeTick(actor_id, tick);
+            ASSERT_EQ(interaction == nullptr, expected == nullptr);
+            if (expected)
+            {
+                EXPECT_EQ(interaction->id_, expected->id_);
+            }
+            ActorStatus status = chronicle.FindActorStatusDuringTick(actor_id, tick);
+            ActorStatus expected_status = resident_chronicle.FindActorStatusDuringTick(actor_id, tick);
+            ASSERT_NE(status.wealth, nullptr);
+            EXPECT_EQ(status.wealth->id_, expected_status.wealth->id_);
+            for (size_t type_index = 0; type_index < status.emotions.size(); ++type_index)
+            {
+                ASSERT_NE(status.emotions[type_index], nullptr);
+                EXPECT_EQ(status.emotions[type_index]->id_, expected_status.emotions[type_index]->id_);
+            }
+        }
+    }
+    chronicle.Reset();
+    EXPECT_EQ(chronicle.GetSpilledKernelAmount(), 0u);
+    std::remove(setting.spill_path.c_str());
+}
+
+TEST(TaleKernels, TattleRunsOnSpilledChronicle)
+{
+    Setting setting;
+    setting.actor_count = 40;
+    setting.days_to_simulate = 10;
+    setting.spill_tick_horizon = 5;
+    setting.spill_path = "tattled_chronicle_test.bin";
+    Random random;
+    Chronicle chronicle(random);
+    Tale(chronicle, random, setting);
+    ASSERT_GT(chronicle.GetSpilledKernelAmount(), 0u);
+    std::string narrative = Tattle(chronicle, setting);
+    EXPECT_NE(narrative.find("Whole Simulation Rarity Curation"), std::string::npos);
+    EXPECT_EQ(narrative.find("Whole Simulation Rarity Curation failed"), std::string::npos);
+    chronicle.Reset();
+    std::remove(setting.spill_path.c_str());
+}
+
+TEST_F(TaleSimulatedChronicle, ChainStreamMatchesEveryPossibleChain)
+{
+    std::string path = "chain_stream_test.bin";
+    ASSERT_TRUE(MappedChronicle::Write(chronicle_, path));
+    MappedChronicle mapped;
+    ASSERT_TRUE(mapped.Open(path));
+
+    const auto &chains = chronicle_.GetEveryPossibleChain(setting_.max_chain_size);
+    // small blocks, so releasing and prefetching happens many times
+    ChainStream stream(mapped, setting_.max_chain_size, 64);
+    std::vector<uint32_t> chain;
+    size_t chain_count = 0;
+    while (stream.Next(chain))
+    {
+        ASSERT_LT(chain_count, chains.size());
+        const auto &expected = chains[chain_count++];
+        ASSERT_EQ(chain.size(), expected.size());
+        for (size_t i = 0; i < chain.size(); ++i)
+        {
+            EXPECT_EQ(chain[i], expected[i]->id_);
+        }
+    }
+    EXPECT_EQ(chain_count, chains.size());
+    EXPECT_FALSE(stream.Next(chain));
+
+    RarityCuration curation(setting_.max_chain_size);
+    float highest_score = 0.0f;
+    std::vector<uint32_t> highest_chain;
+    for (const auto &kernel_chain : chains)
+    {
+        float score = curation.CalculateScore(kernel_chain);
+        if (score > highest_score)
+        {
+            highest_score = score;
+            highest_chain.clear();
+            for (auto kernel : kernel_chain)
+            {
+                highest_chain.push_back(static_cast<uint32_t>(kernel->id_));
+            }
+        }
+    }
+    EXPECT_EQ(Curator::FindRarestChain(mapped, setting_.max_chain_size), highest_chain);
+    mapped.Close();
+    std::remove(path.c_str());
+}
+
+TEST_F(TaleSimulatedChronicle, ChronicleArchiveRoundTrip)
+{
+    std::string path = "chronicle_archive_test.bin";
+    std::string mapped_path = "chronicle_archive_test_mapped.bin";
+    ASSERT_TRUE(ChronicleArchive::Write(chronicle_, path));
+    ASSERT_TRUE(MappedChronicle::Write(chronicle_, mapped_path));
+
+    ChronicleArchive archive;
+    ASSERT_TRUE(archive.Open(path));
+    const auto &kernels = chronicle_.FindKernels(KernelQuery());
+    ASSERT_EQ(archive.GetKernelAmount(), kernels.size());
+    ASSERT_EQ(archive.GetActorNames().size(), setting_.actor_count);
+    for (size_t actor_id = 0; actor_id < setting_.actor_count; ++actor_id)
+    {
+        EXPECT_EQ(archive.GetActorNames()[actor_id], chronicle_.actors_[actor_id]->name_);
+    }
+    ArchivedKernel archived_kernel;
+    size_t kernel_count = 0;
+    while (archive.Next(archived_kernel))
+    {
+        ASSERT_LT(kernel_count, kernels.size());
+        Kernel *kernel = kernels[kernel_count++];
+        MappedChronicle::KernelRecord expected = MappedChronicle::CreateKernelRecord(kernel, 0);
+        const auto &record = archived_kernel.record;
+        EXPECT_EQ(archived_kernel.id, kernel->id_);
+        EXPECT_EQ(archived_kernel.name, kernel->name_);
+        EXPECT_EQ(record.tick, expected.tick);
+        EXPECT_EQ(record.type, expected.type);
+        EXPECT_EQ(record.owner_id, expected.owner_id);
+        EXPECT_EQ(record.subtype, expected.subtype);
+        EXPECT_EQ(record.target_id, expected.target_id);
+        EXPECT_EQ(record.chance, expected.chance);
+        EXPECT_NEAR(record.value, expected.value, 1.0f / ChronicleArchive::value_scale_);
+        ASSERT_EQ(archived_kernel.reason_ids.size(), kernel->GetReasons().size());
+        for (size_t i = 0; i < archived_kernel.reason_ids.size(); ++i)
+        {
+            EXPECT_EQ(archived_kernel.reason_ids[i], kernel->GetReasons()[i]->id_);
+        }
+        const auto &participants = kernel->GetAllParticipants();
+        ASSERT_EQ(archived_kernel.participant_ids.size(), participants.size());
+        for (size_t i = 0; i < participants.size(); ++i)
+        {
+            EXPECT_EQ(archived_kernel.participant_ids[i], participants[i]->id_);
+        }
+    }
+    EXPECT_EQ(kernel_count, kernels.size());
+    archive.Close();
+
+    std::ifstream archive_file(path, std::ios::binary | std::ios::ate);
+    std::ifstream mapped_file(mapped_path, std::ios::binary | std::ios::ate);
+    // the fixed size records are already smaller than the Kernel objects in memory
+    EXPECT_LE(archive_file.tellg() * 5, mapped_file.tellg());
+    archive_file.close();
+    mapped_file.close();
+    EXPECT_FALSE(archive.Open("does_not_exist.bin"));
+    std::remove(path.c_str());
+    std::remove(mapped_path.c_str());
+}
+
+TEST_F(TaleSimulatedChronicle, ChronicleColumnsMatchChronicle)
+{
+    std::string prefix = "chronicle_columns_test";
+    ASSERT_TRUE(ChronicleColumns::Write(chronicle_, prefix));
+
+    auto read_column = [&prefix](const std::string &column, auto value_type)
+    {
+        std::ifstream file(ChronicleColumns::GetColumnPath(prefix, column), std::ios::binary | std::ios::ate);
+        std::vector<decltype(value_type)> values(static_cast<size_t>(file.tellg()) / sizeof(value_type));
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(value_type));
+        return values;
+    };
+    auto ids = read_column("id", uint32_t());
+    auto ticks = read_column("tick", uint64_t());
+    auto types = read_column("type", uint8_t());
+    auto owners = read_column("owner", uint32_t());
+    auto targets = read_column("target", uint32_t());
+    auto prototypes = read_column("prototype", uint32_t());
+    auto subtypes = read_column("subtype", uint32_t());
+    auto chances = read_column("chance", float());
+    auto values = read_column("value", float());
+    auto edges_from = read_column("edge_from", uint32_t());
+    auto edges_to = read_column("edge_to", uint32_t());
+
+    const auto &kernels = chronicle_.FindKernels(KernelQuery());
+    ASSERT_EQ(ids.size(), kernels.size());
+    ASSERT_EQ(ticks.size(), kernels.size());
+    ASSERT_EQ(types.size(), kernels.size());
+    ASSERT_EQ(owners.size(), kernels.size());
+    ASSERT_EQ(targets.size(), kernels.size());
+    ASSERT_EQ(prototypes.size(), kernels.size());
+    ASSERT_EQ(subtypes.size(), kernels.size());
+    ASSERT_EQ(chances.size(), kernels.size());
+    ASSERT_EQ(values.size(), kernels.size());
+    ASSERT_EQ(edges_from.size(), edges_to.size());
+    size_t edge_count = 0;
+    for (size_t i = 0; i < kernels.size(); ++i)
+    {
+        Kernel *kernel = kernels[i];
+        MappedChronicle::KernelRecord expected = MappedChronicle::CreateKernelRecord(kernel, 0);
+        EXPECT_EQ(ids[i], kernel->id_);
+        EXPECT_EQ(ticks[i], expected.tick);
+        EXPECT_EQ(types[i], expected.type);
+        EXPECT_EQ(owners[i], expected.owner_id);
+        EXPECT_EQ(targets[i], expected.target_id);
+        EXPECT_EQ(chances[i], expected.chance);
+        EXPECT_EQ(values[i], expected.value);
+        if (kernel->type_ == KernelType::kInteraction)
+        {
+            EXPECT_EQ(prototypes[i], expected.subtype);
+            EXPECT_EQ(subtypes[i], ChronicleColumns::missing_id_);
+        }
+        else
+        {
+            EXPECT_EQ(prototypes[i], ChronicleColumns::missing_id_);
+        }
+        for (auto reason : kernel->GetReasons())
+        {
+            ASSERT_LT(edge_count, edges_from.size());
+            EXPECT_EQ(edges_from[edge_count], reason->id_);
+            EXPECT_EQ(edges_to[edge_count], kernel->id_);
+            ++edge_count;
+        }
+    }
+    EXPECT_EQ(edge_count, edges_from.size());
+
+    std::ifstream schema(ChronicleColumns::GetSchemaPath(prefix));
+    std::string line;
+    ASSERT_TRUE(std::getline(schema, line));
+    EXPECT_EQ(line, "tattletale_columns " + std::to_string(ChronicleColumns::version_));
+    ASSERT_TRUE(std::getline(schema, line));
+    EXPECT_EQ(line, "kernels " + std::to_string(kernels.size()));
+    ASSERT_TRUE(std::getline(schema, line));
+    EXPECT_EQ(line, "edges " + std::to_string(edge_count));
+    schema.close();
+    std::remove(ChronicleColumns::GetSchemaPath(prefix).c_str());
+    for (auto column : {"id", "tick", "type", "owner", "target", "prototype", "subtype", "chance", "value", "edge_from", "edge_to"})
+    {
+        std::remove(ChronicleColumns::GetColumnPath(prefix, column).c_str());
+    }
+}